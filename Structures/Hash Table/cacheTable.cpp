@@ -0,0 +1,158 @@
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <new>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include "cacheTable.h"
+
+long long allocations = 0; // Counted by the replaced operator new below.
+
+void *operator new(std::size_t bytes) {
+	++allocations;
+	void *memory = std::malloc(bytes == 0 ? 1 : bytes);
+	if (memory == nullptr) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void operator delete(void *memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+	std::free(memory);
+}
+
+std::string slowLookup(const int key) {
+	return "Row " + std::to_string(key); // Stands in for a slow backing store.
+}
+
+bool matchesReferenceLru(const int capacity, const int keys, const int rounds) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Drive an lru cacheTable and a plain std::list + std::unordered_map LRU with the same random calls.
+	Every lookup must agree on hit or miss and value, and the counters must match.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	cacheTable<int, int> C(capacity, cachePolicy::lru);
+	std::list<std::pair<int, int>> order; // Most recent first.
+	std::unordered_map<int, std::list<std::pair<int, int>>::iterator> where;
+	long long hits = 0, misses = 0, evictions = 0;
+	std::mt19937 generator(5);
+
+	for (int i = 0; i < rounds; ++i) {
+		const int key = static_cast<int>(generator() % keys);
+		const int call = static_cast<int>(generator() % 10);
+		if (call < 5) {
+			const int *value = C.find(key);
+			const auto found = where.find(key);
+			if (found == where.end()) {
+				++misses;
+				if (value != nullptr) {
+					return false;
+				}
+			}
+			else {
+				++hits;
+				order.splice(order.begin(), order, found->second);
+				if (value == nullptr || *value != found->second->second) {
+					return false;
+				}
+			}
+		}
+		else if (call < 9) {
+			C.insert(key, i);
+			const auto found = where.find(key);
+			if (found != where.end()) {
+				found->second->second = i;
+				order.splice(order.begin(), order, found->second);
+			}
+			else {
+				if (static_cast<int>(order.size()) == capacity) {
+					where.erase(order.back().first);
+					order.pop_back();
+					++evictions;
+				}
+				order.push_front({ key, i });
+				where[key] = order.begin();
+			}
+		}
+		else {
+			C.remove(key);
+			const auto found = where.find(key);
+			if (found != where.end()) {
+				order.erase(found->second);
+				where.erase(found);
+			}
+		}
+	}
+	const cacheStats stats = C.statistics();
+	return stats.hits == hits && stats.misses == misses && stats.evictions == evictions &&
+		C.howManyEntries() == static_cast<int>(order.size());
+}
+
+int main()
+{
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Gain a few insights on how to use the cache, and see a testable demo that checks it against a reference LRU
+	and counts allocations while it is in use.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::cout << "A cacheTable holds at most a fixed number of entries, here 3, and evicts the least recently used:\n";
+	cacheTable<int, std::string> C(3);
+	for (int key : { 1, 2, 3, 1, 4 }) {
+		if (C.find(key) == nullptr) {
+			C.insert(key, slowLookup(key));
+		}
+	}
+	C.print();
+	std::cout << "2 was evicted when 4 came in, since 1 had just been used again.\n";
+	C.statistics().print();
+
+	std::cout << "\nWith cachePolicy::clock a hit only marks the entry, and eviction gives marked entries a second chance:\n";
+	cacheTable<int, std::string> K(3, cachePolicy::clock);
+	for (int key : { 1, 2, 3, 1, 4 }) {
+		if (K.find(key) == nullptr) {
+			K.insert(key, slowLookup(key));
+		}
+	}
+	K.print();
+	K.statistics().print();
+
+	std::cout << "\nRandom finds, inserts and removes compared against a std::list LRU: ";
+	const bool lruPassed = matchesReferenceLru(100, 300, 200000);
+	std::cout << (lruPassed ? "passed" : "FAILED") << "\n";
+
+	std::cout << "A full cache of each policy serving 1,000,000 more calls makes no allocations: ";
+	bool quiet = true;
+	for (cachePolicy policy : { cachePolicy::lru, cachePolicy::clock }) {
+		cacheTable<int, int> Q(1000, policy);
+		std::mt19937 generator(3);
+		for (int i = 0; i < 1000; ++i) {
+			Q.insert(i, i);
+		}
+		const long long before = allocations;
+		for (int i = 0; i < 1000000; ++i) {
+			const int key = static_cast<int>(generator() % 4000);
+			if (Q.find(key) == nullptr) {
+				Q.insert(key, i);
+			}
+			if (i % 7 == 0) {
+				Q.remove(key);
+			}
+		}
+		quiet = quiet && (allocations == before) && Q.howManyEntries() <= Q.capacity();
+	}
+	std::cout << (quiet ? "passed" : "FAILED") << "\n\n";
+
+	std::cin.get();
+	return (lruPassed && quiet) ? 0 : 1;
+}
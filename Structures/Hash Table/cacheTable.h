@@ -0,0 +1,305 @@
+#pragma once
+/// ------------------------------------------------------------------------------------ ///
+/*
+The following .h file includes a bounded cache: a hashTable index in front of a fixed pool of entries,
+... which evicts by LRU or CLOCK once the pool is full.
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <iostream>
+#include <vector>
+#include "hashTable.h"
+
+enum class cachePolicy { lru, clock };
+
+struct cacheStats {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Counters of a cacheTable since it was made. Lookups that found the key are hits, the rest misses.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	long long hits;
+	long long misses;
+	long long evictions;
+
+	double hitRatio() const {
+		const long long lookups = this->hits + this->misses;
+		return (lookups == 0) ? 0.0 : static_cast<double>(this->hits) / lookups;
+	}
+
+	void print() const {
+		std::cout << "Hits: " << this->hits << " | Misses: " << this->misses << " | Evictions: " << this->evictions << \
+			" | Hit ratio: " << hitRatio() << "\n";
+	}
+};
+
+template <typename K, typename V, typename Hash = hashMixer<K>>
+class cacheTable {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	A hashTable that never stops growing makes a poor cache. This one holds at most maxEntries entries: when
+	... a new key arrives and the pool is full, the entry least likely to be needed again is evicted.
+	The bound is a count of entries, not of bytes. Every entry is charged the same, so a V that owns memory
+	... of its own (the characters of a long std::string, say) can make the real footprint larger than the
+	... pool; pick maxEntries with the typical size of a value in mind.
+
+	All memory is taken up front. Entries live in one vector of nodes, and the index maps a key to its node.
+	The index uses the robinHood strategy, whose removals leave no tombstones, so with a fixed number of
+	... entries it never grows or rebuilds. After construction no operation allocates (beyond what copying
+	... a K or V does), and each is O(1).
+
+	cachePolicy::lru keeps the nodes on an intrusive doubly linked list (indices inside the nodes, no
+	... separate list nodes). A hit moves its node to the front, the back is evicted.
+	cachePolicy::clock gives every node a referenced bit instead. A hit only sets the bit, which is cheaper
+	... than relinking. To evict, a hand sweeps the nodes, clearing set bits until it finds a clear one,
+	... so entries used since the last sweep get a second chance. O(1) amortized.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+private:
+
+	struct cacheNode {
+		K key;
+		V value;
+		int previous; // Towards the most recently used, -1 at the front (lru only).
+		int next; // Towards the least recently used, -1 at the back. Also links the free nodes.
+		bool used;
+		bool referenced; // clock only.
+	};
+
+	std::vector<cacheNode> nodes;
+	hashTable<K, int, Hash> index;
+	const cachePolicy policy;
+	int front; // Most recently used node (lru).
+	int back; // Least recently used node (lru).
+	int freeNodes; // First node of the free list.
+	int hand; // Next node the clock looks at.
+	int entries;
+	cacheStats stats;
+
+	void unlink(const int node) {
+		cacheNode &entry = this->nodes[node];
+		(entry.previous == -1 ? this->front : this->nodes[entry.previous].next) = entry.next;
+		(entry.next == -1 ? this->back : this->nodes[entry.next].previous) = entry.previous;
+	}
+
+	void linkFront(const int node) {
+		cacheNode &entry = this->nodes[node];
+		entry.previous = -1;
+		entry.next = this->front;
+		(this->front == -1 ? this->back : this->nodes[this->front].previous) = node;
+		this->front = node;
+	}
+
+	void touch(const int node) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Record a use of node: move it to the front of the list, or set its referenced bit.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->policy == cachePolicy::lru) {
+			if (this->front != node) {
+				unlink(node);
+				linkFront(node);
+			}
+		}
+		else {
+			this->nodes[node].referenced = true;
+		}
+	}
+
+	int victim() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Pick the node to evict from a full cache: the back of the list, or the first node the clock hand finds
+		... with a clear referenced bit. Every node is in use when this is called.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->policy == cachePolicy::lru) {
+			return this->back;
+		}
+		while (this->nodes[this->hand].referenced) {
+			this->nodes[this->hand].referenced = false;
+			this->hand = (this->hand + 1) % static_cast<int>(this->nodes.size());
+		}
+		const int chosen = this->hand;
+		this->hand = (this->hand + 1) % static_cast<int>(this->nodes.size());
+		return chosen;
+	}
+
+	void release(const int node) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Take node out of the index and the list, and put it on the free list.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		cacheNode &entry = this->nodes[node];
+		this->index.remove(entry.key);
+		if (this->policy == cachePolicy::lru) {
+			unlink(node);
+		}
+		entry.used = false;
+		entry.referenced = false;
+		entry.next = this->freeNodes;
+		this->freeNodes = node;
+		--(this->entries);
+	}
+
+	int *lookup(const K &key) {
+		int *node = this->index.find(key);
+		if (node == nullptr) {
+			++(this->stats.misses);
+		}
+		else {
+			++(this->stats.hits);
+			touch(*node);
+		}
+		return node;
+	}
+
+public:
+
+	cacheTable(const int maxEntries, const cachePolicy policyParam = cachePolicy::lru, const Hash &hashParam = Hash()) :
+		nodes(maxEntries < 1 ? 1 : maxEntries), index(maxEntries < 1 ? 1 : maxEntries, probeStrategy::robinHood, hashParam),
+		policy(policyParam), front(-1), back(-1), freeNodes(0), hand(0), entries(0), stats{ 0, 0, 0 } {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Allocate every node and the index for maxEntries entries now (at least one), and chain the nodes into
+		... the free list. The cache's own memory is fixed from here on: maxEntries nodes of a K and a V, and an
+		... index of a K and a node number per slot. Memory a K or V holds outside of itself isn't counted.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		for (int i = 0; i < static_cast<int>(this->nodes.size()); ++i) {
+			this->nodes[i].used = false;
+			this->nodes[i].referenced = false;
+			this->nodes[i].next = (i + 1 < static_cast<int>(this->nodes.size())) ? i + 1 : -1;
+		}
+	}
+
+	void insert(const K &key, const V &value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Cache value under key. An existing entry for key is overwritten and counts as used.
+		A new key takes a free node, or evicts one if the cache is full.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int *existing = this->index.find(key);
+		if (existing != nullptr) {
+			this->nodes[*existing].value = value;
+			touch(*existing);
+			return;
+		}
+
+		if (this->freeNodes == -1) {
+			release(victim());
+			++(this->stats.evictions);
+		}
+		const int node = this->freeNodes;
+		cacheNode &entry = this->nodes[node];
+		this->freeNodes = entry.next;
+
+		entry.key = key;
+		entry.value = value;
+		entry.used = true;
+		entry.referenced = false;
+		if (this->policy == cachePolicy::lru) {
+			linkFront(node);
+		}
+		this->index.insert(key, node);
+		++(this->entries);
+	}
+
+	V *find(const K &key) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		A pointer to the cached value of key, or nullptr on a miss. Counts a hit or a miss.
+		The pointer is valid until key is evicted or removed.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int *node = lookup(key);
+		return (node == nullptr) ? nullptr : &(this->nodes[*node].value);
+	}
+
+	V at(const K &key) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Returns the cached value of key. On a miss, throws keyNotFound.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int *node = lookup(key);
+		if (node == nullptr) {
+			throw keyNotFound();
+		}
+		return this->nodes[*node].value;
+	}
+
+	bool contains(const K &key) {
+		return this->index.contains(key); // Doesn't count as a use.
+	}
+
+	void remove(const K &key) {
+		int *node = this->index.find(key);
+		if (node != nullptr) {
+			release(*node);
+		}
+	}
+
+	cacheStats statistics() {
+		return this->stats;
+	}
+
+	int howManyEntries() {
+		return this->entries;
+	}
+
+	int capacity() {
+		return static_cast<int>(this->nodes.size());
+	}
+
+	bool isEmpty() {
+		return (this->entries == 0);
+	}
+
+	void print() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Print the entries, most recently used first with lru, in node order with clock.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		std::cout << "\n----------------------------\n" << \
+			"Cache Capacity: " << this->nodes.size() << " | Entries: " << this->entries << "\n";
+		if (this->policy == cachePolicy::lru) {
+			for (int node = this->front; node != -1; node = this->nodes[node].next) {
+				std::cout << "Key: " << this->nodes[node].key << " | Value: " << this->nodes[node].value << "\n";
+			}
+		}
+		else {
+			for (const cacheNode &entry : this->nodes) {
+				if (entry.used) {
+					std::cout << "Key: " << entry.key << " | Value: " << entry.value << \
+						(entry.referenced ? " (referenced)" : "") << "\n";
+				}
+			}
+		}
+		std::cout << "----------------------------\n";
+	}
+};
@@ -0,0 +1,42 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "concurrentHashTable.h"
+
+int main()
+{
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Gain a few insights on how to use the concurrent table, and see a testable demo that fills it from several threads.
+	Build with threads enabled, e.g. g++ -std=c++17 -pthread concurrentHashTable.cpp
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::cout << "A concurrentHashTable is declared like a hashTable, plus the number of shards (default 64):\n";
+	concurrentHashTable<int, std::string> C(1000, 8);
+	std::cout << "Shards: " << C.shardCount() << "\n";
+
+	std::cout << "\nFour threads insert 250 entries each, at the same time:\n";
+	std::vector<std::thread> workers;
+	for (int t = 0; t < 4; ++t) {
+		workers.emplace_back([&C, t]() {
+			for (int i = t * 250; i < (t + 1) * 250; ++i) {
+				C.insert(i, "Entry " + std::to_string(i));
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	std::cout << "Entries: " << C.howManyEntries() << "\n";
+
+	std::cout << "\nValues are copied out under the shard's lock. Value of 512: " << C.at(512) << "\n";
+	std::string value;
+	C.remove(512);
+	std::cout << "After removing 512, find returns: " << C.find(512, value) << " | contains 511: " << C.contains(511) << "\n";
+	std::cout << "\n";
+	std::cin.get();
+	return 0;
+}
@@ -0,0 +1,158 @@
+#pragma once
+/// ------------------------------------------------------------------------------------ ///
+/*
+The following .h file includes a thread safe hash table, made of independently locked hashTable shards.
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+#include "hashTable.h"
+
+template <typename K, typename V, typename Hash = hashMixer<K>>
+class concurrentHashTable {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	A hashTable is not safe to share between threads. This class splits the key space into a power of two
+	... number of shards, each its own hashTable behind its own reader-writer lock (lock striping).
+	A key always lives in the same shard, chosen from bits of its hash that the shard's table doesn't use
+	... for its home slot or tag. Threads working on different shards never wait for each other.
+
+	Reads take their shard's lock shared, so any number of readers proceed together and only wait while a
+	... writer holds that one shard. A seqlock would skip even that, but a reader racing a writer could
+	... then see a table mid-rehash or half of a std::string, so readers copy values out under the lock.
+	Readers only reach their shard's table through a const reference, so they use its const lookups, which
+	... never write anything (not even the probe histograms of a HASH_TABLE_STATS build).
+	Values are returned by copy for the same reason: a pointer would outlive the lock.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+private:
+
+	struct alignas(64) shard {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		One stripe. Aligned to a cache line so two shards' locks never share a line (false sharing).
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		mutable std::shared_mutex lock;
+		hashTable<K, V, Hash> table;
+
+		shard(const int sizeParam, const probeStrategy strategy, const Hash &hasher) : table(sizeParam, strategy, hasher) {}
+	};
+
+	std::vector<std::unique_ptr<shard>> shards;
+	int shardMask;
+	Hash hasher;
+
+	template <typename Q>
+	shard &shardOf(const Q &key) const {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Bits 7 and up of the hash pick the shard. The low 7 bits are the table's tag, and the home slot
+		... comes from the top bits after the table's multiply-shift.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const std::uint64_t hashed = static_cast<std::uint64_t>(this->hasher(key));
+		return *(this->shards[static_cast<int>(hashed >> 7) & this->shardMask]);
+	}
+
+public:
+
+	concurrentHashTable(const int sizeParam, const int shardCount = 64,
+		const probeStrategy strategy = probeStrategy::linear, const Hash &hashParam = Hash()) : hasher(hashParam) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		shardCount is rounded up to a power of two. Aim for a few times the number of threads.
+		sizeParam is the expected number of entries for the whole table, split evenly over the shards.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int count = 1;
+		while (count < shardCount) {
+			count *= 2;
+		}
+		this->shardMask = count - 1;
+		for (int i = 0; i < count; ++i) {
+			this->shards.emplace_back(new shard(sizeParam / count + 1, strategy, hashParam));
+		}
+	}
+
+	void insert(const K &key, const V &value) {
+		shard &owner = shardOf(key);
+		std::unique_lock<std::shared_mutex> guard(owner.lock);
+		owner.table.insert(key, value);
+	}
+
+	void remove(const K &key) {
+		shard &owner = shardOf(key);
+		std::unique_lock<std::shared_mutex> guard(owner.lock);
+		owner.table.remove(key);
+	}
+
+	bool find(const K &key, V &out) const {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Copy the value of key into out and return true, or return false if the key doesn't exist.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const shard &owner = shardOf(key);
+		std::shared_lock<std::shared_mutex> guard(owner.lock);
+		const V *value = owner.table.find(key);
+		if (value == nullptr) {
+			return false;
+		}
+		out = *value;
+		return true;
+	}
+
+	V at(const K &key) const {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Returns a copy of the value of key. If the key doesn't exist, throws keyNotFound.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const shard &owner = shardOf(key);
+		std::shared_lock<std::shared_mutex> guard(owner.lock);
+		return owner.table.at(key);
+	}
+
+	bool contains(const K &key) const {
+		const shard &owner = shardOf(key);
+		std::shared_lock<std::shared_mutex> guard(owner.lock);
+		return owner.table.contains(key);
+	}
+
+	int howManyEntries() const {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Sum of every shard's entries. Each shard is read under its own lock, so with concurrent writers the
+		... total is only a snapshot.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int total = 0;
+		for (const std::unique_ptr<shard> &owner : this->shards) {
+			std::shared_lock<std::shared_mutex> guard(owner->lock);
+			total += owner->table.howManyEntries();
+		}
+		return total;
+	}
+
+	int shardCount() const {
+		return this->shardMask + 1;
+	}
+};
@@ -0,0 +1,105 @@
+/// ------------------------------------------------------------------------------------ ///
+/*
+Multithreaded throughput of the concurrent hash table. Build with optimizations and threads:
+g++ -O2 -std=c++17 -pthread concurrentHashTableBenchmark.cpp -o concurrentHashTableBenchmark
+Pass the number of operations per thread as the first argument (default 1,000,000).
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "concurrentHashTable.h"
+
+const int keySpace = 1 << 20;
+
+struct globalLockTable {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Baseline: one hashTable behind one mutex, what sharing a plain hashTable safely costs.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::mutex lock;
+	hashTable<int, int> table;
+
+	globalLockTable() : table(keySpace) {}
+
+	void insert(const int key, const int value) {
+		std::lock_guard<std::mutex> guard(this->lock);
+		this->table.insert(key, value);
+	}
+
+	bool find(const int key, int &out) {
+		std::lock_guard<std::mutex> guard(this->lock);
+		const int *value = this->table.find(key);
+		if (value == nullptr) {
+			return false;
+		}
+		out = *value;
+		return true;
+	}
+};
+
+template <typename Table>
+double run(Table &table, const int threads, const int operations, const int writePercent) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Every thread does operations random lookups and inserts (writePercent of them inserts) on the shared
+	... table. Returns millions of operations per second over all threads.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::vector<std::thread> workers;
+	const auto start = std::chrono::steady_clock::now();
+	for (int t = 0; t < threads; ++t) {
+		workers.emplace_back([&table, t, operations, writePercent]() {
+			std::mt19937 generator(t + 1);
+			int found = 0, value = 0;
+			for (int i = 0; i < operations; ++i) {
+				const int key = static_cast<int>(generator() % keySpace);
+				if (static_cast<int>(generator() % 100) < writePercent) {
+					table.insert(key, i);
+				}
+				else {
+					found += table.find(key, value);
+				}
+			}
+			if (found < 0) {
+				std::cout << value; // Keeps the lookups alive.
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return (static_cast<double>(threads) * operations) / seconds / 1000000.0;
+}
+
+int main(int argc, char **argv) {
+
+	const int operations = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+	const int threadCounts[] = { 1, 2, 4, 8, 16 };
+	const int writePercents[] = { 10, 50 };
+
+	std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n";
+	for (int writePercent : writePercents) {
+		std::cout << "\n" << writePercent << "% inserts, " << operations << " operations per thread\n";
+		for (int threads : threadCounts) {
+			concurrentHashTable<int, int> sharded(keySpace, 64);
+			globalLockTable global;
+			const double shardedRate = run(sharded, threads, operations, writePercent);
+			const double globalRate = run(global, threads, operations, writePercent);
+			std::cout << threads << " threads | sharded: " << shardedRate << " Mops/s | one mutex: " << globalRate << " Mops/s\n";
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include "cuckooTable.h"
+
+int main()
+{
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Gain a few insights on how to use the cuckoo table, and see a testable demo that checks it against std::unordered_map.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::cout << "A cuckooTable is declared like a hashTable, and has the same insert / at / remove:\n";
+	cuckooTable<std::string, int> T(4);
+	T.insert("Bulbasaur", 1);
+	T.insert("Charmander", 4);
+	T.insert("Squirtle", 7);
+	T.insert("Pikachu", 25);
+	T.print();
+	std::cout << "Value of Squirtle: " << T.at("Squirtle") << "\n";
+	T.remove("Squirtle");
+	try {
+		T.at("Squirtle");
+	}
+	catch (keyNotFound &error) {
+		std::cout << "After removing Squirtle, at() throws: " << error.what() << "\n";
+	}
+
+	std::cout << "\nEvery key can only be in one of two buckets of four, so a lookup never checks more than 8 slots.\n" << \
+		"Inserting displaces entries to their other bucket to make room, and the table fills to ~95% before growing:\n";
+	cuckooTable<int, int> C(100000);
+	const int capacity = C.capacity();
+	int filled = 0;
+	while (C.capacity() == capacity) {
+		C.insert(filled * 7919, filled);
+		++filled;
+	}
+	std::cout << "Capacity " << capacity << " held " << filled - 1 << " entries before growing (" << \
+		(100.0 * (filled - 1) / capacity) << "% load).\n";
+
+	std::cout << "\nRandom inserts and removes, compared against std::unordered_map: ";
+	cuckooTable<int, int> R(16);
+	std::unordered_map<int, int> expected;
+	std::mt19937 generator(9);
+	bool passed = true;
+	for (int i = 0; i < 200000 && passed; ++i) {
+		const int key = static_cast<int>(generator() % 20000);
+		if (generator() % 3) {
+			R.insert(key, i);
+			expected.insert({ key, i });
+		}
+		else {
+			R.remove(key);
+			expected.erase(key);
+		}
+		const int *value = R.find(key);
+		passed = (value == nullptr) ? (expected.count(key) == 0) : (expected.count(key) == 1 && *value == expected[key]);
+	}
+	for (const std::pair<const int, int> &entry : expected) {
+		passed = passed && R.contains(entry.first) && R.at(entry.first) == entry.second;
+	}
+	passed = passed && (R.howManyEntries() == static_cast<int>(expected.size()));
+	std::cout << (passed ? "passed" : "FAILED") << " (" << R.howManyEntries() << " entries, " << R.stashed() << " stashed)\n\n";
+
+	std::cin.get();
+	return passed ? 0 : 1;
+}
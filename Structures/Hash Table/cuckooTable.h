@@ -0,0 +1,332 @@
+#pragma once
+/// ------------------------------------------------------------------------------------ ///
+/*
+The following .h file includes a bucketized cuckoo hash table: two candidate buckets per key, four slots per bucket.
+A lookup reads at most those two buckets (plus a tiny stash that is almost always empty), so it is O(1) worst case.
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <iostream>
+#include <vector>
+#include "hashTable.h"
+
+template <typename K, typename V, typename Hash = hashMixer<K>>
+class cuckooTable {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Every key has two possible buckets, each bucket holds up to four entries. A key is only ever stored in one
+	... of its two buckets, so at() / find() / remove() look at 8 slots and nothing else, no matter how full the
+	... table is. Linear probing can degrade to long scans, this cannot.
+
+	The price is paid by insert: when both buckets are full, a resident entry is kicked out to its other
+	... bucket, which may kick another, and so on. The walk is bounded by maxDisplacements. If it runs out,
+	... the entry left in hand goes to a small stash, and once the stash is full the table doubles.
+	With 4-way buckets the table reaches ~95% load before that happens.
+
+	The same surface as hashTable: insert, remove, at, find, contains, howManyEntries, isEmpty, print.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+private:
+
+	enum : int { ways = 4, maxDisplacements = 128, maxStash = 8 };
+
+	struct alignas(64) cuckooBucket {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Four slots and their tags (controlGroup::empty or 7 bits of the hash). Cache line aligned: with small
+		... keys and values one bucket is one line, so a lookup touches at most two lines.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		std::int8_t tags[ways];
+		Bucket<K, V> slots[ways];
+
+		cuckooBucket() {
+			for (std::int8_t &tag : this->tags) {
+				tag = controlGroup::empty;
+			}
+		}
+	};
+
+	std::vector<cuckooBucket> buckets;
+	std::vector<Bucket<K, V>> stash; // Entries no bucket could take, checked by every lookup when non-empty.
+	int shift; // 64 - log2(buckets), for multiply-shift.
+	int entries;
+	std::uint64_t randomState; // xorshift state, picks which entry to kick.
+	Hash hasher;
+
+	template <typename Q>
+	std::uint64_t hash(const Q &key) {
+		return static_cast<std::uint64_t>(this->hasher(key));
+	}
+
+	int firstBucket(const std::uint64_t hashed) {
+		return homeSlotOf(hashed, this->shift);
+	}
+
+	int secondBucket(const std::uint64_t hashed) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		The second hash function: a different odd multiplier over the same 64-bit hash. Never the same bucket
+		... as the first, so a key really has two choices.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const int second = static_cast<int>((hashed * 0xC2B2AE3D27D4EB4Full) >> this->shift);
+		return (second == firstBucket(hashed)) ? (second ^ 1) : second;
+	}
+
+	int randomWay() {
+		this->randomState ^= this->randomState << 13;
+		this->randomState ^= this->randomState >> 7;
+		this->randomState ^= this->randomState << 17;
+		return static_cast<int>(this->randomState % ways);
+	}
+
+	template <typename Q>
+	bool locate(const Q &key, int &bucket, int &way) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Look in the two buckets of key, then the stash. On a hit, bucket / way say where the entry is, with
+		... way == -1 meaning bucket is an index into the stash. Returns false if the key isn't there.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const std::uint64_t hashed = hash(key);
+		const std::int8_t tag = tagOf(hashed);
+		const int candidates[2] = { firstBucket(hashed), secondBucket(hashed) };
+
+		for (int candidate : candidates) {
+			cuckooBucket &home = this->buckets[candidate];
+			for (int i = 0; i < ways; ++i) {
+				if (home.tags[i] == tag && home.slots[i].key == key) {
+					bucket = candidate;
+					way = i;
+					return true;
+				}
+			}
+		}
+		for (int i = 0; i < static_cast<int>(this->stash.size()); ++i) {
+			if (this->stash[i].key == key) {
+				bucket = i;
+				way = -1;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template <typename Q>
+	Bucket<K, V> *findEntry(const Q &key) {
+		int bucket, way;
+		if (!locate(key, bucket, way)) {
+			return nullptr;
+		}
+		return (way < 0) ? &(this->stash[bucket]) : &(this->buckets[bucket].slots[way]);
+	}
+
+	bool placeInBucket(const int bucket, const std::int8_t tag, Bucket<K, V> &entry) {
+		cuckooBucket &home = this->buckets[bucket];
+		for (int way = 0; way < ways; ++way) {
+			if (home.tags[way] == controlGroup::empty) {
+				home.slots[way] = std::move(entry);
+				home.tags[way] = tag;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool place(Bucket<K, V> entry) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Store an entry known not to be in the table. Try both buckets, then walk: kick a random resident of
+		... the current bucket, take its slot, and carry the kicked entry to its other bucket.
+		Returns false with the carried entry added to the stash if the walk ran out.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		std::uint64_t hashed = hash(entry.key);
+		std::int8_t tag = tagOf(hashed);
+		int bucket = firstBucket(hashed);
+		if (placeInBucket(bucket, tag, entry) || placeInBucket(secondBucket(hashed), tag, entry)) {
+			return true;
+		}
+
+		for (int kicks = 0; kicks < maxDisplacements; ++kicks) {
+			cuckooBucket &home = this->buckets[bucket];
+			const int way = randomWay();
+			std::swap(entry, home.slots[way]);
+			std::swap(tag, home.tags[way]);
+
+			hashed = hash(entry.key);
+			const int first = firstBucket(hashed);
+			bucket = (bucket == first) ? secondBucket(hashed) : first; // The kicked entry's other bucket.
+			if (placeInBucket(bucket, tag, entry)) {
+				return true;
+			}
+		}
+		this->stash.push_back(std::move(entry));
+		return false;
+	}
+
+	void grow() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Double the bucket count and reinsert everything, stash included. Unlike hashTable this is a full
+		... rehash, it only happens once the table is ~95% full or the displacement walks keep failing.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		std::vector<cuckooBucket> old(this->buckets.size() * 2);
+		old.swap(this->buckets);
+		std::vector<Bucket<K, V>> oldStash;
+		oldStash.swap(this->stash);
+		--(this->shift);
+
+		for (cuckooBucket &bucket : old) {
+			for (int way = 0; way < ways; ++way) {
+				if (bucket.tags[way] != controlGroup::empty) {
+					place(std::move(bucket.slots[way]));
+				}
+			}
+		}
+		for (Bucket<K, V> &entry : oldStash) {
+			place(std::move(entry));
+		}
+	}
+
+public:
+
+	cuckooTable(const int sizeParam, const Hash &hashParam = Hash()) : shift(64), entries(0), randomState(0x2545F4914F6CDD1Dull), hasher(hashParam) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Start with a power of two number of buckets, enough for sizeParam entries at 90% load.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int count = 2;
+		while (static_cast<long long>(count) * ways * 9 < static_cast<long long>(sizeParam) * 10) {
+			count *= 2;
+		}
+		this->buckets.resize(count);
+		for (int bits = count; bits > 1; bits /= 2) {
+			--(this->shift);
+		}
+	}
+
+	void insert(const K &key, const V &value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Insert an entry, ignoring keys already in the table. Grows past 95% load or once the stash is full.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (findEntry(key) != nullptr) {
+			return; // We've already inserted this entry.
+		}
+		if (static_cast<long long>(this->entries + 1) * 20 > static_cast<long long>(this->buckets.size()) * ways * 19) {
+			grow();
+		}
+		place(Bucket<K, V>(key, value));
+		++(this->entries);
+		while (static_cast<int>(this->stash.size()) > maxStash) {
+			grow();
+		}
+	}
+
+	void remove(const K &key) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Empty the slot of key. A freed slot may give a stashed entry a home, so one is retried.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int bucket, way;
+		if (!locate(key, bucket, way)) {
+			return; // Value isn't in the table.
+		}
+		--(this->entries);
+
+		if (way < 0) {
+			this->stash.erase(this->stash.begin() + bucket);
+			return;
+		}
+		this->buckets[bucket].tags[way] = controlGroup::empty;
+		this->buckets[bucket].slots[way] = Bucket<K, V>();
+
+		if (!this->stash.empty()) {
+			Bucket<K, V> retry = std::move(this->stash.back());
+			this->stash.pop_back();
+			place(std::move(retry));
+		}
+	}
+
+	V at(const K &key) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Returns the value of key. If the key doesn't exist, throws keyNotFound.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		Bucket<K, V> *entry = findEntry(key);
+		if (entry == nullptr) {
+			throw keyNotFound();
+		}
+		return entry->value;
+	}
+
+	V *find(const K &key) {
+		Bucket<K, V> *entry = findEntry(key);
+		return (entry == nullptr) ? nullptr : &(entry->value);
+	}
+
+	bool contains(const K &key) {
+		return (findEntry(key) != nullptr);
+	}
+
+	int howManyEntries() {
+		return this->entries;
+	}
+
+	int capacity() {
+		return static_cast<int>(this->buckets.size()) * ways;
+	}
+
+	int stashed() {
+		return static_cast<int>(this->stash.size());
+	}
+
+	bool isEmpty() {
+		return (this->entries == 0);
+	}
+
+	void print() {
+		std::cout << "\n----------------------------\n" << \
+			"Cuckoo Table Buckets: " << this->buckets.size() << " x " << static_cast<int>(ways) << "\n";
+		for (int i = 0; i < static_cast<int>(this->buckets.size()); ++i) {
+			for (int way = 0; way < ways; ++way) {
+				if (this->buckets[i].tags[way] != controlGroup::empty) {
+					std::cout << "[" << i << "] ";
+					this->buckets[i].slots[way].print();
+				}
+			}
+		}
+		for (Bucket<K, V> &entry : this->stash) {
+			std::cout << "[stash] ";
+			entry.print();
+		}
+		std::cout << "----------------------------\n";
+	}
+};
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include "denseHashTable.h"
+
+template <valueLayout layout>
+bool matchesUnorderedMap(const int rounds) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Random inserts and removes on a denseHashTable<int, std::string> and a std::unordered_map, checked after every call.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	denseHashTable<int, std::string> D(4, layout);
+	std::unordered_map<int, std::string> expected;
+	std::mt19937 generator(static_cast<int>(layout) + 11);
+	for (int i = 0; i < rounds; ++i) {
+		const int key = static_cast<int>(generator() % 5000);
+		if (generator() % 3) {
+			const std::string value = "Value " + std::to_string(i) + " with enough text to leave the small string buffer";
+			D.insert(key, value);
+			expected.insert({ key, value });
+		}
+		else {
+			D.remove(key);
+			expected.erase(key);
+		}
+		const std::string *value = D.find(key);
+		const auto found = expected.find(key);
+		if ((value == nullptr) != (found == expected.end()) || (value != nullptr && *value != found->second)) {
+			return false;
+		}
+	}
+	for (const std::pair<const int, std::string> &entry : expected) {
+		if (D.at(entry.first) != entry.second) {
+			return false;
+		}
+	}
+	return D.howManyEntries() == static_cast<int>(expected.size());
+}
+
+int main()
+{
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Gain a few insights on how to use the dense table and its two value layouts, and see a testable demo
+	that checks both against std::unordered_map.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::cout << "A denseHashTable keeps tags, keys and values in separate arrays. Lookups only read the keys:\n";
+	denseHashTable<int, std::string> D(8);
+	D.insert(1, "Bulbasaur"); D.insert(4, "Charmander"); D.insert(7, "Squirtle");
+	D.print();
+	std::cout << "Value of 4: " << D.at(4) << " | Bytes held: " << D.memoryUsage() << "\n";
+
+	std::cout << "\nWith valueLayout::outOfLine each slot holds a 4 byte index instead of a 32 byte std::string,\n" << \
+		"and only live values take space:\n";
+	denseHashTable<int, std::string> O(8, valueLayout::outOfLine);
+	O.insert(1, "Bulbasaur"); O.insert(4, "Charmander"); O.insert(7, "Squirtle");
+	O.remove(1);
+	O.print();
+	std::cout << "Value of 7: " << O.at(7) << " | Bytes held: " << O.memoryUsage() << \
+		" | A hashTable of the same size holds: " << hashTable<int, std::string>(8).memoryUsage() << "\n";
+
+	std::cout << "\nRandom inserts and removes compared against std::unordered_map, values in slots: ";
+	const bool inSlotsPassed = matchesUnorderedMap<valueLayout::inSlots>(200000);
+	std::cout << (inSlotsPassed ? "passed" : "FAILED") << "\n";
+	std::cout << "The same, values out of line: ";
+	const bool outOfLinePassed = matchesUnorderedMap<valueLayout::outOfLine>(200000);
+	std::cout << (outOfLinePassed ? "passed" : "FAILED") << "\n\n";
+
+	std::cin.get();
+	return (inSlotsPassed && outOfLinePassed) ? 0 : 1;
+}
@@ -0,0 +1,338 @@
+#pragma once
+/// ------------------------------------------------------------------------------------ ///
+/*
+The following .h file includes a memory-dense hash table: control tags, keys and values are kept in three separate
+... arrays instead of one array of Buckets, and values can be kept out of line, behind 32-bit indices.
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include "hashTable.h"
+
+enum class valueLayout { inSlots, outOfLine };
+
+template <typename K, typename V, typename Hash = hashMixer<K>>
+class denseHashTable {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	hashTable stores a whole Bucket (key and value together) in every slot, so each probe drags the values
+	... through the cache along with the keys, and every empty slot costs sizeof(K) + sizeof(V).
+	Here a probe reads the tags, then only the keys array. The value is touched once, on a hit.
+
+	valueLayout::inSlots keeps a parallel array of values, one per slot. Best when V is small.
+	valueLayout::outOfLine keeps a 32-bit index per slot into a packed array holding only live values, so
+	... an empty slot costs 1 + sizeof(K) + 4 bytes whatever V is. Best for large V (std::string is 32 bytes)
+	... in a sparse table. Removing moves the last packed value into the hole, so the array stays packed.
+
+	Probing is always grouped (16 tags per SSE2 compare, through the findInGroups hashTable uses too), and the
+	... table rebuilds at once when it passes 7/8 full. Only full slots hold constructed keys and values.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+private:
+
+	std::vector<std::int8_t> control;
+	K *keys; // Raw storage, one per slot.
+	V *values; // Raw storage, one per slot (inSlots only).
+	std::unique_ptr<std::uint32_t[]> valueIndex; // Slot -> packed value (outOfLine only).
+	std::vector<V> packed; // Live values (outOfLine only).
+	std::vector<std::uint32_t> owner; // Packed value -> its slot (outOfLine only).
+	int slotCount;
+	int shift;
+	int used; // Full and deleted slots.
+	int entries;
+	const valueLayout layout;
+	Hash hasher;
+
+	template <typename Q>
+	std::uint64_t hash(const Q &key) {
+		return static_cast<std::uint64_t>(this->hasher(key));
+	}
+
+	V &valueAt(const int slot) {
+		return (this->layout == valueLayout::inSlots) ? this->values[slot] : this->packed[this->valueIndex[slot]];
+	}
+
+	void allocate(const int capacity) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Fresh, empty arrays for capacity slots. The old ones must already have been moved out.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		this->control.assign(capacity, controlGroup::empty);
+		this->keys = std::allocator<K>().allocate(capacity);
+		this->values = (this->layout == valueLayout::inSlots) ? std::allocator<V>().allocate(capacity) : nullptr;
+		this->valueIndex.reset((this->layout == valueLayout::outOfLine) ? new std::uint32_t[capacity] : nullptr);
+		this->slotCount = capacity;
+		this->shift = 64;
+		for (int bits = capacity; bits > 1; bits /= 2) {
+			--(this->shift);
+		}
+		this->used = 0;
+	}
+
+	void release() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Destroy the keys and in-slot values of every full slot, and free the slot arrays.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		for (int i = 0; i < this->slotCount; ++i) {
+			if (this->control[i] >= 0) {
+				this->keys[i].~K();
+				if (this->values != nullptr) {
+					this->values[i].~V();
+				}
+			}
+		}
+		std::allocator<K>().deallocate(this->keys, this->slotCount);
+		if (this->values != nullptr) {
+			std::allocator<V>().deallocate(this->values, this->slotCount);
+		}
+	}
+
+	template <typename Q>
+	int findSlot(const Q &key, const std::uint64_t hashed) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Return the slot holding key, or -1. Reads tags and keys only.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int probed;
+		return findInGroups(this->control.data(), this->slotCount, this->shift, hashed,
+			[&](const int slot) { return this->keys[slot] == key; }, probed);
+	}
+
+	int claim(const std::uint64_t hashed) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Take the first free slot for hashed and tag it. The caller constructs the key and value.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const int slot = findFreeInGroups(this->control.data(), this->slotCount, this->shift, hashed);
+		if (this->control[slot] == controlGroup::empty) {
+			++(this->used);
+		}
+		this->control[slot] = tagOf(hashed);
+		return slot;
+	}
+
+	void rebuild(const int capacity) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Move every entry into fresh arrays of capacity slots, dropping the tombstones.
+		Out of line values stay where they are in the packed array, only their indices move.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		std::vector<std::int8_t> oldControl;
+		oldControl.swap(this->control);
+		K *oldKeys = this->keys;
+		V *oldValues = this->values;
+		std::unique_ptr<std::uint32_t[]> oldIndex(std::move(this->valueIndex));
+		const int oldCount = this->slotCount;
+
+		allocate(capacity);
+		for (int i = 0; i < oldCount; ++i) {
+			if (oldControl[i] < 0) {
+				continue;
+			}
+			const int slot = claim(hash(oldKeys[i]));
+			new (&this->keys[slot]) K(std::move(oldKeys[i]));
+			oldKeys[i].~K();
+			if (oldValues != nullptr) {
+				new (&this->values[slot]) V(std::move(oldValues[i]));
+				oldValues[i].~V();
+			}
+			else {
+				this->valueIndex[slot] = oldIndex[i];
+				this->owner[oldIndex[i]] = static_cast<std::uint32_t>(slot);
+			}
+		}
+		std::allocator<K>().deallocate(oldKeys, oldCount);
+		if (oldValues != nullptr) {
+			std::allocator<V>().deallocate(oldValues, oldCount);
+		}
+	}
+
+public:
+
+	denseHashTable(const int sizeParam, const valueLayout layoutParam = valueLayout::inSlots, const Hash &hashParam = Hash()) :
+		keys(nullptr), values(nullptr), slotCount(0), shift(64), used(0), entries(0), layout(layoutParam), hasher(hashParam) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Start with room for sizeParam entries below the 7/8 load limit, at least one group.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int capacity = controlGroup::width;
+		while (static_cast<long long>(capacity) * 7 < static_cast<long long>(sizeParam) * 8) {
+			capacity *= 2;
+		}
+		allocate(capacity);
+	}
+
+	denseHashTable(const denseHashTable &) = delete;
+	denseHashTable &operator=(const denseHashTable &) = delete;
+
+	~denseHashTable() {
+		release();
+	}
+
+	void insert(const K &key, const V &value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Insert an entry, ignoring keys already in the table. Rebuilds first if one more slot would pass 7/8:
+		... at the same capacity if most used slots are tombstones, else at double.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const std::uint64_t hashed = hash(key);
+		if (findSlot(key, hashed) != -1) {
+			return; // We've already inserted this entry.
+		}
+		if (static_cast<long long>(this->used + 1) * 8 > static_cast<long long>(this->slotCount) * 7) {
+			const bool crowded = static_cast<long long>(this->entries) * 16 >= static_cast<long long>(this->slotCount) * 7;
+			rebuild(crowded ? this->slotCount * 2 : this->slotCount);
+		}
+
+		const int slot = claim(hashed);
+		new (&this->keys[slot]) K(key);
+		if (this->layout == valueLayout::inSlots) {
+			new (&this->values[slot]) V(value);
+		}
+		else {
+			this->valueIndex[slot] = static_cast<std::uint32_t>(this->packed.size());
+			this->packed.push_back(value);
+			this->owner.push_back(static_cast<std::uint32_t>(slot));
+		}
+		++(this->entries);
+	}
+
+	void remove(const K &key) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Remove key. A slot whose group still has an empty tag goes back to empty, else it becomes a tombstone.
+		An out of line value is replaced by the last packed value, whose slot is repointed.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const int slot = findSlot(key, hash(key));
+		if (slot == -1) {
+			return; // Value isn't in the table.
+		}
+
+		this->keys[slot].~K();
+		if (this->layout == valueLayout::inSlots) {
+			this->values[slot].~V();
+		}
+		else {
+			const std::uint32_t hole = this->valueIndex[slot];
+			const std::uint32_t last = static_cast<std::uint32_t>(this->packed.size() - 1);
+			if (hole != last) {
+				this->packed[hole] = std::move(this->packed[last]);
+				this->owner[hole] = this->owner[last];
+				this->valueIndex[this->owner[hole]] = hole;
+			}
+			this->packed.pop_back();
+			this->owner.pop_back();
+		}
+
+		const int base = slot & ~(controlGroup::width - 1);
+		if (controlGroup::matchEmpty(&this->control[base])) {
+			this->control[slot] = controlGroup::empty;
+			--(this->used);
+		}
+		else {
+			this->control[slot] = controlGroup::deleted;
+		}
+		--(this->entries);
+	}
+
+	V at(const K &key) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Returns the value of key. If the key doesn't exist, throws keyNotFound.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const int slot = findSlot(key, hash(key));
+		if (slot == -1) {
+			throw keyNotFound();
+		}
+		return valueAt(slot);
+	}
+
+	V *find(const K &key) {
+		const int slot = findSlot(key, hash(key));
+		return (slot == -1) ? nullptr : &valueAt(slot);
+	}
+
+	bool contains(const K &key) {
+		return (findSlot(key, hash(key)) != -1);
+	}
+
+	int howManyEntries() {
+		return this->entries;
+	}
+
+	int capacity() {
+		return this->slotCount;
+	}
+
+	bool isEmpty() {
+		return (this->entries == 0);
+	}
+
+	long long memoryUsage() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Bytes held by the table's own arrays. Memory a K or V owns itself (a long std::string's buffer) isn't
+		... included, it's the same whatever the layout.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		long long bytes = static_cast<long long>(this->slotCount) * (1 + sizeof(K));
+		if (this->layout == valueLayout::inSlots) {
+			bytes += static_cast<long long>(this->slotCount) * sizeof(V);
+		}
+		else {
+			bytes += static_cast<long long>(this->slotCount) * sizeof(std::uint32_t);
+			bytes += static_cast<long long>(this->packed.capacity()) * sizeof(V);
+			bytes += static_cast<long long>(this->owner.capacity()) * sizeof(std::uint32_t);
+		}
+		return bytes;
+	}
+
+	void print() {
+		std::cout << "\n----------------------------\n" << \
+			"Dense Hash Table Capacity: " << this->slotCount << " | Values: " << \
+			(this->layout == valueLayout::inSlots ? "in slots" : "out of line") << "\n";
+		for (int i = 0; i < this->slotCount; ++i) {
+			if (this->control[i] >= 0) {
+				std::cout << "Key: " << this->keys[i] << " | Value: " << valueAt(i) << "\n";
+			}
+		}
+		std::cout << "----------------------------\n";
+	}
+};
@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "hashMultimap.h"
+
+int main()
+{
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Gain a few insights on how to use the multimap, and see a testable demo that checks it against a std::map of vectors.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::cout << "A hashMultimap keeps every value inserted under a key, here pokemon grouped by type:\n";
+	hashMultimap<std::string, std::string> M(8);
+	M.insert("Grass", "Bulbasaur"); M.insert("Fire", "Charmander"); M.insert("Water", "Squirtle");
+	M.insert("Grass", "Oddish"); M.insert("Water", "Psyduck"); M.insert("Grass", "Bellsprout");
+	M.print();
+
+	std::cout << "\nat() returns a span over one key's values, stored next to each other in insertion order:\n";
+	for (const std::string &name : M.at("Grass")) {
+		std::cout << name << " ";
+	}
+	std::cout << "\nGrass: " << M.count("Grass") << " | Electric: " << M.count("Electric") << "\n";
+	M.remove("Water");
+	std::cout << "After removing Water, keys: " << M.howManyKeys() << " | values: " << M.howManyValues() << "\n";
+
+	std::cout << "\nRandom inserts and removes compared against a std::map of std::vector: ";
+	hashMultimap<int, int> R(4);
+	std::map<int, std::vector<int>> expected;
+	std::mt19937 generator(17);
+	int values = 0;
+	bool passed = true;
+	for (int i = 0; i < 100000 && passed; ++i) {
+		const int key = static_cast<int>(generator() % 500);
+		if (generator() % 10) {
+			R.insert(key, i);
+			expected[key].push_back(i);
+			++values;
+		}
+		else {
+			R.remove(key);
+			values -= static_cast<int>(expected[key].size());
+			expected.erase(key);
+		}
+		const valueSpan<int> span = R.at(key);
+		const std::vector<int> &group = expected[key];
+		passed = (span.size == static_cast<int>(group.size())) && std::equal(span.begin(), span.end(), group.begin());
+		if (group.empty()) {
+			expected.erase(key);
+		}
+	}
+	passed = passed && (R.howManyValues() == values) && (R.howManyKeys() == static_cast<int>(expected.size()));
+	std::cout << (passed ? "passed" : "FAILED") << "\n\n";
+
+	std::cin.get();
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+#pragma once
+/// ------------------------------------------------------------------------------------ ///
+/*
+The following .h file includes a hash multimap: any number of values per key, each key's values kept together
+... in one contiguous span.
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <iostream>
+#include <vector>
+#include "hashTable.h"
+
+template <typename V>
+struct valueSpan {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	A view of the values of one key: a pointer to the first and how many there are. Usable in a range-for.
+	Valid until the next insert or remove on the multimap.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	const V *data;
+	int size;
+
+	const V *begin() const {
+		return this->data;
+	}
+
+	const V *end() const {
+		return this->data + this->size;
+	}
+
+	bool empty() const {
+		return (this->size == 0);
+	}
+
+	const V &operator[](const int index) const {
+		return this->data[index];
+	}
+};
+
+template <typename K, typename V, typename Hash = hashMixer<K>>
+class hashMultimap {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	A hashTable from each key to a std::vector of its values. Adding a value is a single upsert that appends
+	... in place, so grouping events by key costs one probe per event. All of a key's values sit in one array,
+	... in insertion order, so scanning a group reads contiguous memory.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+private:
+
+	hashTable<K, std::vector<V>, Hash> groups;
+	int values;
+
+public:
+
+	hashMultimap(const int sizeParam, const probeStrategy strategy = probeStrategy::linear, const Hash &hashParam = Hash()) :
+		groups(sizeParam, strategy, hashParam), values(0) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		sizeParam is the expected number of distinct keys.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+	}
+
+	void insert(const K &key, const V &value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Add value to the values of key, after any it already has. Duplicate values are kept.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		this->groups.upsert(key, [&value](std::vector<V> &group) { group.push_back(value); });
+		++(this->values);
+	}
+
+	valueSpan<V> at(const K &key) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Returns the values of key. An unknown key has an empty span, so no keyNotFound is thrown.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const std::vector<V> *group = this->groups.find(key);
+		if (group == nullptr) {
+			return valueSpan<V>{ nullptr, 0 };
+		}
+		return valueSpan<V>{ group->data(), static_cast<int>(group->size()) };
+	}
+
+	int count(const K &key) {
+		const std::vector<V> *group = this->groups.find(key);
+		return (group == nullptr) ? 0 : static_cast<int>(group->size());
+	}
+
+	bool contains(const K &key) {
+		return this->groups.contains(key);
+	}
+
+	void remove(const K &key) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Remove key and all of its values.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		this->values -= count(key);
+		this->groups.remove(key);
+	}
+
+	int howManyKeys() {
+		return this->groups.howManyEntries();
+	}
+
+	int howManyValues() {
+		return this->values;
+	}
+
+	bool isEmpty() {
+		return (this->values == 0);
+	}
+
+	void print() {
+		std::cout << "\n----------------------------\n" << \
+			"Hash Multimap Keys: " << howManyKeys() << " | Values: " << howManyValues() << "\n";
+		for (Bucket<K, std::vector<V>> &group : this->groups) {
+			std::cout << "Key: " << group.key << " | Values:";
+			for (const V &value : group.value) {
+				std::cout << " " << value;
+			}
+			std::cout << "\n";
+		}
+		std::cout << "----------------------------\n";
+	}
+};
@@ -7,21 +7,20 @@ void continuePrompt();
 
 int main()
 {
-	std::cout << "First, we create a hashtable with a size of 5. Try to predict an accurate limit of possible entries.\n";
-	std::cout << "Default initialized hashtable of type K = int, V = str:";
-	std::cout << "\n(Note that this hashtable is only implemented for K = int and V = str)\n";
+	std::cout << "First, we create a hashtable with a size of 5. The size is only a starting point, the table grows as it fills.\n";
+	std::cout << "Default initialized hashtable of type K = int, V = str:\n";
 	hashTable<int, std::string> H(5);
 	H.print();
 
 	std::cout << "\nNext, we insert pokedex entries into the table. \n" << \
-		"Insertions test collisions, full table, and more. Explained in comments. \n";
+		"Insertions test collisions, going past the starting size, and more. Explained in comments. \n";
 	H.insert(34, "Nidoking"); // Insertion Test
 	H.insert(34, "Nidoking"); // Reinserting Same Entry
 	H.insert(33, "Nidorino"); // Inserting Entry before a used space
 	H.insert(32, "NidoranM"); // ... Inserting ... 
 	H.insert(30, "Nidorina"); // Inserting entry at the beginning. 
 	H.insert(40, "Wigglytuff"); // Inserting entry at COLLISION (start). Should go to 2.
-	H.insert(112, "Rhydon"); // Inserting entry into a FULL table.
+	H.insert(112, "Rhydon"); // Inserting past the starting size of 5.
 	H.print();
 	continuePrompt();
 	
@@ -31,7 +30,13 @@ int main()
 	H.print();
 	std::cout << "\nPrinting entry 34's value: ";
 	std::cout << H.at(34);
-	std::cout << "\nPrinting an entry that doesn't exist will try to print nullptr and throw.\n";
+	std::cout << "\nPrinting an entry that doesn't exist will throw keyNotFound: ";
+	try {
+		std::cout << H.at(151);
+	}
+	catch (const keyNotFound &error) {
+		std::cout << error.what() << "\n";
+	}
 	continuePrompt();
 
 	std::cout << "\nLastly, we will showcase H2, where we let K = str, V = int:";
@@ -43,7 +48,116 @@ int main()
 	std::cout << "\n";
 
 	continuePrompt();
-    return 0;
+	std::cout << "\nThe grouped strategy keeps the same interface, but probes 16 control tags at a time.\n" << \
+		"Tags replace sentinel keys, so -1 and -2 are ordinary keys now:";
+	hashTable<int, std::string> H3(20, probeStrategy::grouped);
+	H3.insert(-1, "MissingNo"); H3.insert(-2, "Glitch"); H3.insert(25, "Pikachu");
+	H3.remove(-2);
+	H3.print();
+	std::cout << "Value of key -1: " << H3.at(-1) << "\n";
+
+	continuePrompt();
+	std::cout << "\nWhen 7/8 of the slots are used, the capacity doubles. The old slots are moved over a few at a time\n" << \
+		"by each insert and remove, so no single insertion pays for rehashing the whole table:\n";
+	hashTable<int, int> H4(8);
+	for (int i = 0; i < 14; ++i) {
+		H4.insert(i * 7, i);
+	}
+	std::cout << "Entries: " << H4.howManyEntries() << " | Capacity: " << H4.capacity() << " | Rehashing: " << H4.isRehashing() << "\n";
+	H4.insert(1000, 1000);
+	std::cout << "Entries: " << H4.howManyEntries() << " | Capacity: " << H4.capacity() << " | Rehashing: " << H4.isRehashing() << "\n";
+	H4.remove(0);
+	std::cout << "Entries: " << H4.howManyEntries() << " | Capacity: " << H4.capacity() << " | Rehashing: " << H4.isRehashing() << "\n";
+	std::cout << "Value of key 91, found after the move: " << H4.at(91) << "\n";
+
+	continuePrompt();
+	std::cout << "\nThe robinHood strategy evens out probe lengths, and removes without leaving tombstones.\n" << \
+		"probeStatistics reports how far entries sit from their home slot:\n";
+	hashTable<int, int> H5(64, probeStrategy::robinHood);
+	for (int i = 0; i < 48; ++i) {
+		H5.insert(i * 64, i); // Every key wants the same home slot.
+	}
+	H5.probeStatistics().print();
+	for (int i = 0; i < 24; ++i) {
+		H5.remove(i * 64);
+	}
+	std::cout << "After removing half of them, the rest shift back toward home:\n";
+	H5.probeStatistics().print();
+
+	continuePrompt();
+	std::cout << "\nString keys can be looked up with a std::string_view or a literal, no std::string is built:\n";
+	const std::string line = "Bulbasaur,Ivysaur,Venusaur";
+	const std::string_view firstWord = std::string_view(line).substr(0, 9);
+	hashTable<std::string, int> H6(8);
+	H6.insert("Bulbasaur", 1); H6.insert("Ivysaur", 2);
+	std::cout << "Contains " << firstWord << ": " << H6.contains(firstWord) << " | Value: " << H6.at(firstWord) << "\n";
+	std::cout << "Contains Venusaur: " << H6.contains("Venusaur") << "\n";
+
+	std::cout << "\nWith arenaString keys, the table copies key bytes into its own append-only arena,\n" << \
+		"and each bucket only holds a view of them:";
+	hashTable<arenaString, int> H7(8);
+	H7.insert(std::string_view(line).substr(10, 7), 2);
+	H7.insert(std::string_view(line).substr(18, 8), 3);
+	H7.print();
+	std::cout << "Value of Venusaur: " << H7.at("Venusaur") << "\n";
+
+	continuePrompt();
+	std::cout << "\nfindBatch looks up many keys at once, prefetching their slots before resolving them:\n";
+	const int wanted[] = { 34, 151, 30, 62 };
+	std::string *found[4];
+	H.findBatch(wanted, 4, found);
+	for (int i = 0; i < 4; ++i) {
+		std::cout << wanted[i] << ": " << (found[i] ? *found[i] : "not found") << "\n";
+	}
+
+	continuePrompt();
+	std::cout << "\nThe table can be walked with iterators (or a range-for), empty slots are skipped 16 at a time:\n";
+	int total = 0;
+	for (Bucket<int, std::string> &entry : H) {
+		total += entry.key;
+	}
+	std::cout << "Sum of the pokedex numbers in H: " << total << "\n";
+
+	std::cout << "\nreserve() sizes a table once before a big load, and insertBulk() reserves for a whole range:\n";
+	std::vector<std::pair<int, std::string>> starters = { { 1, "Bulbasaur" }, { 4, "Charmander" }, { 7, "Squirtle" } };
+	hashTable<int, std::string> H8(1);
+	H8.reserve(1000);
+	std::cout << "Capacity after reserve(1000): " << H8.capacity() << "\n";
+	H8.insertBulk(starters.begin(), starters.end());
+	H8.print();
+
+	continuePrompt();
+	std::cout << "\ntableStatistics() reports how healthy a table is: occupancy, tombstones and the longest cluster.\n" << \
+		"Build with -DHASH_TABLE_STATS=1 and it also keeps histograms of probe lengths for insert, at and remove:\n";
+	hashTable<int, int> H9(64);
+	for (int i = 0; i < 400; ++i) {
+		H9.insert(i, i);
+		if (i % 2) {
+			H9.remove(i - 1);
+		}
+	}
+	H9.contains(3); H9.contains(4);
+	H9.tableStatistics().print();
+	std::cout << "A copy keeps the entries and the histograms recorded so far, and so does a move: ";
+	hashTable<int, int> H9Copy(H9);
+	const tableStats copied = H9Copy.tableStatistics();
+	hashTable<int, int> H9Moved(std::move(H9Copy));
+	const tableStats before = H9.tableStatistics(), moved = H9Moved.tableStatistics();
+	const bool copyPassed = H9Moved.howManyEntries() == H9.howManyEntries() && H9Moved.at(399) == 399 && \
+		copied.atProbes.operations == before.atProbes.operations && moved.insertProbes.operations == before.insertProbes.operations && \
+		moved.insertProbes.longest == before.insertProbes.longest;
+	std::cout << (copyPassed ? "passed" : "FAILED") << "\n";
+
+	continuePrompt();
+	std::cout << "\nupsert() changes a value in place, inserting it first if needed. Counting in one probe per word:\n";
+	hashTable<std::string, int> H10(8);
+	for (const char *word : { "pika", "chu", "pika", "pika", "chu", "raichu" }) {
+		H10.upsert(word, [](int &count) { ++count; });
+	}
+	H10.print();
+
+	continuePrompt();
+    return copyPassed ? 0 : 1;
 }
 
 void continuePrompt() {
@@ -2,23 +2,72 @@
 /// ------------------------------------------------------------------------------------ ///
 /*
 The following .h file includes an implementation of the hash table structure, using bucket nodes ...
-and linear probing. Implemented cases: K = int, V = str, K = str, V = int.
+and open addressing. Emptiness is tracked in a separate array of 1-byte control tags, so any key is legal.
+The table probes either one slot at a time (linear) or 16 tags at a time (grouped, SSE2 when available).
+Keys are hashed by a pluggable Hash functor, a murmur3 finalizer over std::hash by default.
 */
 /// ------------------------------------------------------------------------------------ ///
 
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iterator>
 #include <memory>
+#include <new>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HASH_TABLE_SSE2 1
+#else
+#define HASH_TABLE_SSE2 0
+#endif
+
+// The probe loops shared by the tables are forced inline. Left to itself the compiler inlines them into the
+// table's findSlot, which then grows too large to be inlined into find(), and lookups slow down by half.
+#if defined(__GNUC__) || defined(__clang__)
+#define HASH_TABLE_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define HASH_TABLE_INLINE __forceinline
+#else
+#define HASH_TABLE_INLINE inline
+#endif
+
+// Define HASH_TABLE_STATS as 1 (before including, or with -DHASH_TABLE_STATS=1) to record probe length histograms.
+// Left at 0, nothing is recorded and no counter exists, so the tables pay nothing for it.
+#ifndef HASH_TABLE_STATS
+#define HASH_TABLE_STATS 0
+#endif
+
+struct keyNotFound : public std::exception {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Custom exception. Thrown by at() when the key was never inserted, instead of handing back a null value.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	const char * what() const throw() {
+		return "Value isn't in the table, the key was not found.";
+	}
+};
 
 template <typename K, typename V>
 struct Bucket {
 
 	/// ------------------------------------------------------------------------------------ ///
 	/*
-	Bucket class is a node / entry of the hash table. 
-	Type K is for the key type, V for the value type. 
-	K will be used for lookup. V should never point to a null object. 
+	Bucket class is a node / entry of the hash table.
+	Type K is for the key type, V for the value type.
+	K will be used for lookup. Whether a bucket is used is recorded by the table's control tags, not the key.
 	*/
 	/// ------------------------------------------------------------------------------------ ///
 
@@ -37,474 +86,1499 @@ struct Bucket {
 		this->value = value;
 	}
 
-	Bucket() {
+	Bucket() : key(), value() {
 
 		/// ------------------------------------------------------------------------------------ ///
 		/*
-		Empty bucket constructor. We assume K is int, V is str.
+		Empty bucket constructor. The key and value are value-initialized, no sentinel is needed.
 		*/
 		/// ------------------------------------------------------------------------------------ ///
 
-		this->key = K(-1);
-		this->value = V("");
 	}
 
 	void print() {
 
 		/// ------------------------------------------------------------------------------------ ///
 		/*
-		Using std::cout, give a formatted view of the key and value of the bucket. 
+		Using std::cout, give a formatted view of the key and value of the bucket.
 		*/
 		/// ------------------------------------------------------------------------------------ ///
 
 		std::cout << "Key: " << this->key << " | Value: " << this->value << "\n";
 	}
 
-	bool isEmpty() {
-
-		/// ------------------------------------------------------------------------------------ ///
-		/*
-		Return true if empty. -1 Means empty since start, -2 means emptied at some point in execution. 
-		*/
-		/// ------------------------------------------------------------------------------------ ///
-
-		return (this->key == K(-1) || this->key == K(-2));
-	}
-
 };
 
-template <typename K, typename V>
-class hashTable {
+struct controlGroup {
 
 	/// ------------------------------------------------------------------------------------ ///
 	/*
-	hashTable class with keys of type K (assumed int) and values V (assumed str.) 
-	Enforces linear probing over chaining methods, and uses sub-struct Buckets to contain entries.
-	The goal of a hashtable is to insert, find, and remove at O(1) time like an array. 
-
-	We use a hashing function to change a key, K, into an integer index for the table, which allows us to access [hypothetically] ~O(1).
-	Sometimes hash functions do not provide a perfect hash :: h(K) may == h(K2) even if K != k2...
-		... Which is why we use linear probing, and thus worst time is O(n) but very unlikely.
+	Helpers for the 1-byte control tags kept next to the buckets. A tag is one of:
+		0 .. 127 : Full, the low 7 bits of the key's hash (cheap filter before comparing keys).
+		empty    : Never used since the last rebuild. A probe can stop here.
+		deleted  : Once used, now removed (tombstone). A probe must continue past it.
+		sentinel : Reserved, never stored in a slot. Every tag below it is free for an insertion.
+	A group is 16 tags, compared at once with SSE2 or one by one with the scalar fallback.
 	*/
 	/// ------------------------------------------------------------------------------------ ///
 
-	private:
-		std::vector<Bucket<K, V>> table;
-		const int size; // intialized size (aim to keep size around this point for optimal time complexity)
-		int contains; // Actual used values in the table. 
+	enum : std::int8_t { empty = -128, deleted = -2, sentinel = -1 };
+	enum : int { width = 16 };
 
-		int hash(K key) {
+	static std::uint32_t match(const std::int8_t *group, const std::int8_t tag) {
 
-			/// ------------------------------------------------------------------------------------ ///
-			/*
-			Rudimentary hash function, modulus is applied to a key by the const size.
-			If K was a string, we could provide specialization and use Berstein's hash.
-			*/
-			/// ------------------------------------------------------------------------------------ ///
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Return a bitmask with bit i set if tag i of the group equals tag.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
 
-			return key % this->size;
+#if HASH_TABLE_SSE2
+		const __m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+		return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(tags, _mm_set1_epi8(tag))));
+#else
+		std::uint32_t mask = 0;
+		for (int i = 0; i < width; ++i) {
+			if (group[i] == tag) {
+				mask |= (1u << i);
+			}
 		}
+		return mask;
+#endif
+	}
 
-	public:
+	static std::uint32_t matchEmpty(const std::int8_t *group) {
+		return match(group, empty);
+	}
 
-		hashTable(const int sizeParam) : size(sizeParam), table(sizeParam, Bucket<K, V>()) {
+	static std::uint32_t matchFree(const std::int8_t *group) {
 
-			/// ------------------------------------------------------------------------------------ ///
-			/*
-			Default initialization, initialization list lets us construct const member. 
-			*/
-			/// ------------------------------------------------------------------------------------ ///
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Return a bitmask of the tags that can take an insertion, empty or deleted. Both are below the sentinel.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
 
-			this->contains = sizeParam;
+#if HASH_TABLE_SSE2
+		const __m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+		return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmplt_epi8(tags, _mm_set1_epi8(sentinel))));
+#else
+		std::uint32_t mask = 0;
+		for (int i = 0; i < width; ++i) {
+			if (group[i] < sentinel) {
+				mask |= (1u << i);
+			}
 		}
+		return mask;
+#endif
+	}
 
-		void insert(const K key, const V &value) {
-
-			/// ------------------------------------------------------------------------------------ ///
-			/*
-			Insert to the bucket. O(1) time if no collision. Else, possible O(n) time. 
-			If the bucket is full, we will append to the bucket.
-			This appending will slow down the overall speed of the hash table.
-			*/
-			/// ------------------------------------------------------------------------------------ ///
+	static std::uint32_t matchFull(const std::int8_t *group) {
 
-			const Bucket<K, V> insertion(key, value);
-			int position = hash(key);
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Return a bitmask of the full tags. Full tags are the only ones with the sign bit clear.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
 
-			if (this->table[position].isEmpty()) {
-				this->table[position] = insertion;
-				return; // No collision, so the insertion is complete at O(1)! 
-			}
-			else if (this->table[position].key == key) {
-				return; // We've already inserted this entry.
-			}
-			else {
-				// Collision
-				++position;
-				while (position < ((this->size) - 1)) {
-					if (this->table[position].isEmpty()) {
-						this->table[position] = insertion;
-						return; // Entry inserted. 
-					}
-					else if (this->table[position].key == key) {
-						return; // We've already inserted this entry.
-					}
-					else {
-						++position; // The next slot is full. Continue. 
-						continue;
-					}
-				}
-				// If we haven't returned yet, then there aren't any open spaces.
-				// We've now traversed ~O(n) regions, which is pretty uncool.
-				++(this->contains);
-				this->table.push_back(insertion);
+#if HASH_TABLE_SSE2
+		const __m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+		return static_cast<std::uint32_t>(~_mm_movemask_epi8(tags)) & 0xFFFFu;
+#else
+		std::uint32_t mask = 0;
+		for (int i = 0; i < width; ++i) {
+			if (group[i] >= 0) {
+				mask |= (1u << i);
 			}
 		}
+		return mask;
+#endif
+	}
 
-		void remove(const K &key) {
-
-			/// ------------------------------------------------------------------------------------ ///
-			/*
-			Replace a bucket in the table vector with a "once used but now empty" bucket object.
-			O(1) if no collision, else possible O(n).
-			*/
-			/// ------------------------------------------------------------------------------------ ///
+	static int lowestBit(const std::uint32_t mask) {
 
-			const Bucket<K, V> successor(-2, "nullptr");
-			int position = hash(key);
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Index of the lowest set bit of a non-zero mask.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
 
-			if (this->table[position].key == key) {
-				// The key was placed without any collision.
-				this->table[position] = successor;
-				--(this->contains);
-				return;
-			}
-			else {
-				// Either the key doesn't exist, or the key was placed in collision.
-				++position;
-				while (position < ((this->size) - 1)) {
-					if (this->table[position].isEmpty()) {
-						return; // The key doesn't exist
-					}
-					else if (this->table[position].key == key) {
-						// We've found the key. Delete it.
-						this->table[position] = successor;
-						--(this->contains);
-						return;
-					}
-					else {
-						// There's still more elements that could be key.
-						++position;
-						continue;
-					}
-				}
-			}
-			return; // Value isn't in the table.
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctz(mask);
+#else
+		int bit = 0;
+		while (!(mask & (1u << bit))) {
+			++bit;
 		}
+		return bit;
+#endif
+	}
+};
 
-		V at(const K &key) {
+/// ------------------------------------------------------------------------------------ ///
+/*
+Grouped probing over an array of control tags, shared by hashTable's grouped strategy and denseHashTable.
+The tables keep their keys differently, so a probe is handed the tags, the capacity (a power of two, at least
+... one group) and the multiply-shift amount, and calls back to compare keys.
+*/
+/// ------------------------------------------------------------------------------------ ///
 
-			/// ------------------------------------------------------------------------------------ ///
-			/*
-			Returns the value at an index in the hash table, K.
-			If the value doesn't exist, returns nullptr.
-			*/
-			/// ------------------------------------------------------------------------------------ ///
+inline int homeSlotOf(const std::uint64_t hashed, const int shift) {
 
-			int position = hash(key);
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Multiply-shift (Fibonacci hashing): multiply by 2^64 / golden ratio and keep the top 64 - shift bits.
+	Cheaper than %, and the top bits depend on every bit of the hash, so even a weak Hash spreads out.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
 
-			if (key == this->table[position].key) {
-				// No collision occured with this key.
-				return (this->table[position].value);
-			}
+	return static_cast<int>((hashed * 0x9E3779B97F4A7C15ull) >> shift);
+}
 
-			else {
-				// A collision occured with the key, so let's find it
-				++position;
-				while (position < (this->size) - 1) {
-					if (this->table[position].isEmpty()) {
-						// Key doesn't exist in the table. 
-						std::cout << "Value isn't in table. RETURNS NULLPTR";
-						return nullptr; // -1 : Empty, -2 : Once Empty, -3 : DNE 
-					}
-					else if (this->table[position].key == key) {
-						// Found the key! 
-						return this->table[position].value;
-					}
-					else {
-						// Looking for more keys. 
-						++(position);
-						continue;
-					}
-				}
-				std::cout << "Value isn't in the table. RETURNING NULLPTR.";
-				return nullptr; // We've reached the end of the table, doesn't exist.
-			}
-		}
+inline std::int8_t tagOf(const std::uint64_t hashed) {
+	return static_cast<std::int8_t>(hashed & 0x7F);
+}
 
-			int howManyEntries() {
-				return this->contains;
-			} 
+template <typename IsKey>
+HASH_TABLE_INLINE int findInGroups(const std::int8_t *control, const int capacity, const int shift, const std::uint64_t hashed,
+	IsKey isKey, int &probed) {
 
-			bool isEmpty() {
-				return (this->contains == 0);
-			}
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Return the slot whose tag matches hashed and for which isKey(slot) is true, or -1 if there is none.
+	Whole groups are probed from the one holding the home slot. probed is set to the number of groups examined.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
 
-			void print() {
-				std::cout << "\n----------------------------\n" << \
-					"Hash Table Starting Size: " << this->size << "\n";
-				for (Bucket<K, V> bucket : this->table) {
-					bucket.print();
-				}
-				std::cout << "----------------------------\n";
+	const std::int8_t tag = tagOf(hashed);
+	const int groups = capacity / controlGroup::width;
+	int base = homeSlotOf(hashed, shift) & ~(controlGroup::width - 1);
+	probed = 0;
+	while (probed < groups) {
+		++probed;
+		std::uint32_t candidates = controlGroup::match(control + base, tag);
+		while (candidates) {
+			const int slot = base + controlGroup::lowestBit(candidates);
+			if (isKey(slot)) {
+				return slot;
 			}
-};
+			candidates &= candidates - 1;
+		}
+		if (controlGroup::matchEmpty(control + base)) {
+			return -1; // An empty tag ends the probe, the key was never pushed past it.
+		}
+		base = (base + controlGroup::width) & (capacity - 1);
+	}
+	return -1;
+}
 
-template <typename V>
-struct Bucket<std::string, V> {
+HASH_TABLE_INLINE int findFreeInGroups(const std::int8_t *control, const int capacity, const int shift, const std::uint64_t hashed) {
 
 	/// ------------------------------------------------------------------------------------ ///
 	/*
-	Bucket class is a node / entry of the hash table.
-	Specialization where we let K = str.
+	Return the first empty or deleted slot in the groups probed for hashed. The caller's load limit
+	... guarantees there is one.
 	*/
 	/// ------------------------------------------------------------------------------------ ///
 
-	std::string key;
-	V value;
+	int base = homeSlotOf(hashed, shift) & ~(controlGroup::width - 1);
+	while (true) {
+		const std::uint32_t free = controlGroup::matchFree(control + base);
+		if (free) {
+			return base + controlGroup::lowestBit(free);
+		}
+		base = (base + controlGroup::width) & (capacity - 1);
+	}
+}
 
-	Bucket(std::string key, V value) {
+template <typename K>
+struct hashMixer {
 
-		/// ------------------------------------------------------------------------------------ ///
-		/*
-		Normal bucket constructor.
-		*/
-		/// ------------------------------------------------------------------------------------ ///
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Default Hash of the table. std::hash is the identity for integers in most standard libraries, so
+	... sequential or strided keys (row IDs, multiples of the capacity) would land in clumps.
+	The murmur3 64-bit finalizer spreads every input bit across the whole result.
+	Any functor returning an integer can replace it, the table's multiply-shift still helps a weak one.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
 
-		this->key = key;
-		this->value = value;
+	static std::uint64_t mix(std::uint64_t hashed) {
+		hashed ^= hashed >> 33;
+		hashed *= 0xFF51AFD7ED558CCDull;
+		hashed ^= hashed >> 33;
+		hashed *= 0xC4CEB9FE1A85EC53ull;
+		hashed ^= hashed >> 33;
+		return hashed;
 	}
 
-	Bucket() {
+	std::uint64_t operator()(const K &key) const {
+		return mix(static_cast<std::uint64_t>(std::hash<K>()(key)));
+	}
+};
 
-		/// ------------------------------------------------------------------------------------ ///
-		/*
-		Empty bucket constructor. We assume K is str, v is int.
-		*/
-		/// ------------------------------------------------------------------------------------ ///
+struct arenaString {
 
-		this->key = "**EMPTY";
-		this->value = V(-1);
-	}
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Key type for the arena mode of the table, a view of bytes the table copied into its own stringArena.
+	A bucket holds just the 16-byte view, so buckets stay small and never allocate.
+	Build one from any string to insert or look up, the table interns the bytes on insertion.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
 
-	void print() {
+	std::string_view view;
 
-		/// ------------------------------------------------------------------------------------ ///
-		/*
-		Using std::cout, give a formatted view of the key and value of the bucket.
-		*/
-		/// ------------------------------------------------------------------------------------ ///
+	arenaString() : view() {}
+	arenaString(const std::string_view viewParam) : view(viewParam) {}
+	arenaString(const char *text) : view(text) {}
+	arenaString(const std::string &text) : view(text) {}
 
-		std::cout << "Key: " << this->key << " | Value: " << this->value << "\n";
+	operator std::string_view() const {
+		return this->view;
 	}
 
-	bool isEmpty() {
+	bool operator==(const std::string_view other) const {
+		return (this->view == other);
+	}
+};
 
-		/// ------------------------------------------------------------------------------------ ///
-		/*
-		Return true if empty. **EMPTY Means empty since start, ***EMPTY means emptied at some point in execution.
-		*/
-		/// ------------------------------------------------------------------------------------ ///
+inline std::ostream &operator<<(std::ostream &out, const arenaString &key) {
+	return out << key.view;
+}
 
-		return (this->key == "**EMPTY" || this->key == "***EMPTY" );
-	}
+template <>
+struct hashMixer<std::string> {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Transparent string hash: std::string, std::string_view and literals all hash as std::string_view,
+	... which the standard guarantees matches std::hash<std::string>.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
 
+	using is_transparent = void;
+
+	std::uint64_t operator()(const std::string_view key) const {
+		return hashMixer<std::string_view>()(key);
+	}
 };
 
-template <typename V>
-class hashTable<std::string, V>{
+template <>
+struct hashMixer<arenaString> : public hashMixer<std::string> {};
+
+struct stringArena {
 
 	/// ------------------------------------------------------------------------------------ ///
 	/*
-	hashTable class with keys of values V (assumed int.)
-	Enforces linear probing over chaining methods, and uses sub-struct Buckets to contain entries.
-	The goal of a hashtable is to insert, find, and remove at O(1) time like an array.
-
-	We use a hashing function to change a key, K, into an integer index for the table, which allows us to access [hypothetically] ~O(1).
-	Sometimes hash functions do not provide a perfect hash :: h(K) may == h(K2) even if K != k2...
-	... Which is why we use linear probing, and thus worst time is O(n) but very unlikely.
+	Append-only storage for arenaString keys. Bytes are copied into large chunks that never move, so views
+	... into them stay valid as the table grows. Removing a key doesn't give its bytes back, they are all
+	... freed with the table. Move-only: a copy would still point into the original chunks.
 	*/
 	/// ------------------------------------------------------------------------------------ ///
 
-private:
-	std::vector<Bucket<std::string, V>> table;
-	const int size; // intialized size (aim to keep size around this point for optimal time complexity)
-	int contains; // Actual used values in the table. 
-
-	int hash(std::string key) {
+	std::vector<std::unique_ptr<char[]>> chunks;
+	std::size_t chunkUsed;
+	std::size_t chunkSize;
+	std::size_t totalBytes;
 
-		/// ------------------------------------------------------------------------------------ ///
-		/*
-		Berstein's hash using binary shift. 
-		*/
-		/// ------------------------------------------------------------------------------------ ///
-		std::hash<std::string> hasher;
-		int index = std::abs((int)hasher(key) % (this->size));
-		return index;
-	}
+	enum : std::size_t { defaultChunk = 64 * 1024 };
 
-public:
+	stringArena() : chunkUsed(0), chunkSize(0), totalBytes(0) {}
+	stringArena(const stringArena &) = delete;
+	stringArena(stringArena &&) = default;
+	stringArena &operator=(const stringArena &) = delete;
+	stringArena &operator=(stringArena &&) = default;
 
-	hashTable(const int sizeParam) : size(sizeParam), table(sizeParam, Bucket<std::string, V>()) {
+	arenaString intern(const arenaString &key) {
 
 		/// ------------------------------------------------------------------------------------ ///
 		/*
-		Default initialization, initialization list lets us construct const member.
+		Copy the key's bytes to the end of the current chunk, starting a new chunk if they don't fit.
 		*/
 		/// ------------------------------------------------------------------------------------ ///
 
-		this->contains = sizeParam;
+		const std::size_t length = key.view.size();
+		if (this->chunks.empty() || this->chunkUsed + length > this->chunkSize) {
+			this->chunkSize = (length > defaultChunk) ? length : static_cast<std::size_t>(defaultChunk);
+			this->chunks.emplace_back(new char[this->chunkSize]);
+			this->chunkUsed = 0;
+		}
+		char *bytes = this->chunks.back().get() + this->chunkUsed;
+		std::copy(key.view.begin(), key.view.end(), bytes);
+		this->chunkUsed += length;
+		this->totalBytes += length;
+		return arenaString(std::string_view(bytes, length));
 	}
+};
 
-	void insert(const std::string key, const V &value) {
-
-		/// ------------------------------------------------------------------------------------ ///
-		/*
-		Insert to the bucket. O(1) time if no collision. Else, possible O(n) time.
-		If the bucket is full, we will append to the bucket.
-		This appending will slow down the overall speed of the hash table.
-		*/
-		/// ------------------------------------------------------------------------------------ ///
+struct noArena {
 
-		const Bucket<std::string, V> insertion(key, value);
-		int position = hash(key);
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Stand-in for stringArena when keys own their bytes. intern hands the key back untouched.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
 
-		if (this->table[position].isEmpty()) {
-			this->table[position] = insertion;
-			return; // No collision, so the insertion is complete at O(1)! 
-		}
-		else if (this->table[position].key == key) {
-			return; // We've already inserted this entry.
-		}
-		else {
-			// Collision
-			++position;
-			while (position < ((this->size) - 1)) {
-				if (this->table[position].isEmpty()) {
-					this->table[position] = insertion;
-					return; // Entry inserted. 
-				}
-				else if (this->table[position].key == key) {
-					return; // We've already inserted this entry.
-				}
-				else {
-					++position; // The next slot is full. Continue. 
-					continue;
-				}
-			}
-			// If we haven't returned yet, then there aren't any open spaces.
-			// We've now traversed ~O(n) regions, which is pretty uncool.
-			++(this->contains);
-			this->table.push_back(insertion);
-		}
+	template <typename K>
+	const K &intern(const K &key) {
+		return key;
 	}
+};
 
-	void remove(const std::string &key) {
+enum class probeStrategy {
 
-		/// ------------------------------------------------------------------------------------ ///
-		/*
-		Replace a bucket in the table vector with a "once used but now empty" bucket object.
-		O(1) if no collision, else possible O(n).
-		*/
-		/// ------------------------------------------------------------------------------------ ///
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	How the table walks its slots on a collision.
+	linear  : One slot at a time, comparing the 1-byte tag before the key.
+	grouped : SwissTable style, 16 tags at a time. The probe starts at the group holding the home slot.
+	robinHood : Linear, but an insertion takes the slot of any entry closer to its home than the insertion is
+		... ("steal from the rich"). Probe lengths even out, a lookup can stop as soon as it passes an entry
+		... closer to home than itself, and removal shifts the cluster back instead of leaving tombstones.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
 
-		const Bucket<std::string, V> successor("***EMPTY", 0);
-		int position = hash(key);
+	linear,
+	grouped,
+	robinHood
+};
 
-		if (this->table[position].key == key) {
-			// The key was placed without any collision.
-			this->table[position] = successor;
-			--(this->contains);
-			return;
-		}
-		else {
-			// Either the key doesn't exist, or the key was placed in collision.
-			++position;
-			while (position < ((this->size) - 1)) {
-				if (this->table[position].isEmpty()) {
-					return; // The key doesn't exist
-				}
-				else if (this->table[position].key == key) {
-					// We've found the key. Delete it.
-					this->table[position] = successor;
-					--(this->contains);
-					return;
-				}
-				else {
-					// There's still more elements that could be key.
-					++position;
-					continue;
-				}
-			}
-		}
-		return; // Value isn't in the table.
+struct probeStats {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Snapshot of how far entries sit from their home slot, in slots. 0 means no collision.
+	The grouped strategy probes whole groups, so its lengths are measured from the start of the home group.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	int entries;
+	double meanProbeLength;
+	double probeLengthVariance;
+	int longestProbe;
+
+	void print() {
+		std::cout << "Entries: " << this->entries << " | Mean probe length: " << this->meanProbeLength << \
+			" | Variance: " << this->probeLengthVariance << " | Longest: " << this->longestProbe << "\n";
 	}
+};
 
-	V at(const std::string &key) {
+struct probeHistogram {
 
-		/// ------------------------------------------------------------------------------------ ///
-		/*
-		Returns the value at an index in the hash table, K.
-		If the value doesn't exist, returns nullptr.
-		*/
-		/// ------------------------------------------------------------------------------------ ///
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Counts of probe lengths for one kind of operation. A probe length is the number of slots (groups, for
+	... the grouped strategy) an operation examined. Bin 0 counts length 1, and bin b lengths
+	... 2^(b-1) + 1 to 2^b, so a growing tail shows up in the high bins. The last bin takes everything longer.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
 
-		int position = hash(key);
+	enum : int { bins = 16 };
 
-		if (key == this->table[position].key) {
-			// No collision occured with this key.
-			return (this->table[position].value);
-		}
+	long long counts[bins];
+	long long operations;
+	long long totalLength;
+	int longest;
 
-		else {
-			// A collision occured with the key, so let's find it
-			++position;
-			while (position < (this->size) - 1) {
-				if (this->table[position].isEmpty()) {
-					// Key doesn't exist in the table. 
-					std::cout << "Value isn't in table. RETURNS NULLPTR";
-					return nullptr; // ** : Empty, *** : Once Empty, -3 : DNE 
-				}
-				else if (this->table[position].key == key) {
-					// Found the key! 
-					return this->table[position].value;
-				}
-				else {
-					// Looking for more keys. 
-					++(position);
-					continue;
-				}
-			}
-			std::cout << "Value isn't in the table. RETURNING NULLPTR.";
-			return nullptr; // We've reached the end of the table, doesn't exist.
+	void record(const int length) {
+		int bin = 0;
+		while (bin < bins - 1 && (1 << bin) < length) {
+			++bin;
+		}
+		++(this->counts[bin]);
+		++(this->operations);
+		this->totalLength += length;
+		if (length > this->longest) {
+			this->longest = length;
 		}
 	}
 
-	int howManyEntries() {
-		return this->contains;
-	}
-
-	bool isEmpty() {
-		return (this->contains == 0);
+	double meanLength() const {
+		return (this->operations == 0) ? 0.0 : static_cast<double>(this->totalLength) / this->operations;
 	}
 
-	void print() {
-		std::cout << "\n----------------------------\n" << \
-			"Hash Table Starting Size: " << this->size << "\n";
-		for (Bucket<std::string, V> bucket : this->table) {
-			bucket.print();
+	void print(const char *name) const {
+		std::cout << name << ": " << this->operations << " probes | Mean length: " << meanLength() << \
+			" | Longest: " << this->longest << " | Histogram:";
+		for (int bin = 0; bin < bins; ++bin) {
+			std::cout << " " << this->counts[bin];
 		}
-		std::cout << "----------------------------\n";
+		std::cout << "\n";
 	}
 };
 
+struct probeRecorder {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Where a table records one probeHistogram as it runs. Lookups record too, and any number of readers may
+	... look up at once (concurrentHashTable's shards take only a shared lock), so every counter is atomic and
+	... bumped with relaxed ordering: no recorded probe is lost, and the counts carry no ordering with them.
+	snapshot() copies the counters out, each of them exact though not all from the same instant.
+	Atomics can't be copied, so copying loads every counter and stores it into the copy. That keeps a table
+	... copyable and movable with the stats on, as it is with them off. There is nothing to steal, so a
+	... move copies too.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::atomic<long long> counts[probeHistogram::bins] = {};
+	std::atomic<long long> operations{ 0 };
+	std::atomic<long long> totalLength{ 0 };
+	std::atomic<int> longest{ 0 };
+
+	probeRecorder() = default;
+
+	probeRecorder(const probeRecorder &other) {
+		*this = other;
+	}
+
+	probeRecorder &operator=(const probeRecorder &other) {
+		for (int bin = 0; bin < probeHistogram::bins; ++bin) {
+			this->counts[bin].store(other.counts[bin].load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+		this->operations.store(other.operations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		this->totalLength.store(other.totalLength.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		this->longest.store(other.longest.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		return *this;
+	}
+
+	void record(const int length) {
+		int bin = 0;
+		while (bin < probeHistogram::bins - 1 && (1 << bin) < length) {
+			++bin;
+		}
+		this->counts[bin].fetch_add(1, std::memory_order_relaxed);
+		this->operations.fetch_add(1, std::memory_order_relaxed);
+		this->totalLength.fetch_add(length, std::memory_order_relaxed);
+		int seen = this->longest.load(std::memory_order_relaxed);
+		while (length > seen && !this->longest.compare_exchange_weak(seen, length, std::memory_order_relaxed)) {
+		}
+	}
+
+	probeHistogram snapshot() const {
+		probeHistogram histogram;
+		for (int bin = 0; bin < probeHistogram::bins; ++bin) {
+			histogram.counts[bin] = this->counts[bin].load(std::memory_order_relaxed);
+		}
+		histogram.operations = this->operations.load(std::memory_order_relaxed);
+		histogram.totalLength = this->totalLength.load(std::memory_order_relaxed);
+		histogram.longest = this->longest.load(std::memory_order_relaxed);
+		return histogram;
+	}
+};
+
+struct probeRecorders {
+	probeRecorder insertProbes;
+	probeRecorder atProbes;
+	probeRecorder removeProbes;
+};
+
+struct tableStats {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Health of a hashTable, for scraping into metrics. Filled by tableStatistics().
+	entries is the real number of live entries. loadFactor is entries / capacity, and tombstones the deleted
+	... slots that lengthen probes until the next rebuild (always 0 with robinHood). pendingMigration counts
+	... entries still in the retiring generation. longestCluster is the longest run of full or deleted
+	... slots, the worst case a probe can walk before reaching an empty one.
+	The histograms are only recorded when HASH_TABLE_STATS is 1, else they stay zero. Lookups through at(),
+	... find(), contains() and findBatch() all count as at, except on a const table, which is never written.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	int entries;
+	int capacity;
+	double loadFactor;
+	int tombstones;
+	int pendingMigration;
+	int longestCluster;
+	bool recordsProbes;
+	probeHistogram insertProbes;
+	probeHistogram atProbes;
+	probeHistogram removeProbes;
+
+	void print() const {
+		std::cout << "Entries: " << this->entries << " | Capacity: " << this->capacity << " | Load factor: " << this->loadFactor << \
+			" | Tombstones: " << this->tombstones << " | Not yet migrated: " << this->pendingMigration << \
+			" | Longest cluster: " << this->longestCluster << "\n";
+		if (!this->recordsProbes) {
+			std::cout << "(Probe lengths are only recorded with HASH_TABLE_STATS defined as 1.)\n";
+			return;
+		}
+		this->insertProbes.print("insert");
+		this->atProbes.print("at    ");
+		this->removeProbes.print("remove");
+	}
+};
+
+template <typename K, typename V>
+struct bucketArray {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	The slots of one table generation: the buckets and their control tags.
+	capacity is always a power of two, and at least one group wide, so the tags split into whole groups.
+	used counts full and deleted tags, since both lengthen probes.
+	distance is only kept by the robinHood strategy, the number of slots each entry sits past its home.
+
+	Buckets are raw storage, only full slots hold a constructed Bucket. A new generation then only has to
+	... fill its tags, instead of constructing (and touching the memory of) every empty bucket up front.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	Bucket<K, V> *buckets;
+	std::vector<std::int8_t> control;
+	std::unique_ptr<std::int32_t[]> distance; // Uninitialized like the buckets, only read for full slots.
+	int capacity;
+	int shift; // 64 - log2(capacity), for the multiply-shift reduction of a hash to a slot.
+	int used;
+
+	bucketArray() : buckets(nullptr), capacity(0), shift(64), used(0) {}
+
+	bucketArray(const int capacityParam, const bool tracksDistance) :
+		buckets(std::allocator<Bucket<K, V>>().allocate(capacityParam)),
+		control(capacityParam, controlGroup::empty), distance(tracksDistance ? new std::int32_t[capacityParam] : nullptr),
+		capacity(capacityParam), shift(64), used(0) {
+		for (int bits = capacityParam; bits > 1; bits /= 2) {
+			--(this->shift);
+		}
+	}
+
+	bucketArray(const bucketArray &other) : bucketArray(other.capacity, other.distance != nullptr) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Deep copy, slot for slot, so the copy keeps the same probe sequences.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		for (int i = 0; i < this->capacity; ++i) {
+			if (other.control[i] >= 0) {
+				new (&this->buckets[i]) Bucket<K, V>(other.buckets[i]);
+			}
+		}
+		this->control = other.control;
+		if (other.distance != nullptr) {
+			std::copy(other.distance.get(), other.distance.get() + other.capacity, this->distance.get());
+		}
+		this->used = other.used;
+	}
+
+	bucketArray(bucketArray &&other) noexcept :
+		buckets(other.buckets), control(std::move(other.control)), distance(std::move(other.distance)),
+		capacity(other.capacity), shift(other.shift), used(other.used) {
+		other.buckets = nullptr;
+		other.control.clear();
+		other.capacity = 0;
+		other.used = 0;
+	}
+
+	bucketArray &operator=(bucketArray other) noexcept {
+		std::swap(this->buckets, other.buckets);
+		std::swap(this->control, other.control);
+		std::swap(this->distance, other.distance);
+		std::swap(this->capacity, other.capacity);
+		std::swap(this->shift, other.shift);
+		std::swap(this->used, other.used);
+		return *this;
+	}
+
+	~bucketArray() {
+		for (int i = 0; i < this->capacity; ++i) {
+			if (this->control[i] >= 0) {
+				this->buckets[i].~Bucket<K, V>();
+			}
+		}
+		if (this->buckets != nullptr) {
+			std::allocator<Bucket<K, V>>().deallocate(this->buckets, this->capacity);
+		}
+	}
+};
+
+template <typename K, typename V>
+struct hashTableIterator {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Forward iterator over the entries of a hashTable, first the current generation then the retiring one.
+	Dereferencing gives the entry's Bucket: change its value freely, but never its key.
+	Empty slots are skipped a group at a time, using the control tags rather than the buckets.
+	Like print(), iterating doesn't change the table, but any insert or remove invalidates every iterator.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	typedef std::forward_iterator_tag iterator_category;
+	typedef Bucket<K, V> value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef Bucket<K, V> *pointer;
+	typedef Bucket<K, V> &reference;
+
+	bucketArray<K, V> *generations[2];
+	int generation; // 2 once past the end.
+	int position;
+
+	hashTableIterator(bucketArray<K, V> *current, bucketArray<K, V> *retiring, const int generationParam) :
+		generations{ current, retiring }, generation(generationParam), position(-1) {
+		if (this->generation < 2) {
+			advance();
+		}
+		else {
+			this->position = 0;
+		}
+	}
+
+	void advance() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Move to the next full slot after position, moving on to the next generation when one runs out.
+		Capacities are whole groups, so the scan reads aligned groups of 16 tags.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int next = this->position + 1;
+		while (this->generation < 2) {
+			const bucketArray<K, V> &slots = *(this->generations[this->generation]);
+			int base = next & ~(controlGroup::width - 1);
+			while (base < slots.capacity) {
+				std::uint32_t mask = controlGroup::matchFull(&slots.control[base]);
+				if (base < next) {
+					mask &= ~((1u << (next - base)) - 1); // Ignore the slots already visited.
+				}
+				if (mask != 0) {
+					this->position = base + controlGroup::lowestBit(mask);
+					return;
+				}
+				base += controlGroup::width;
+			}
+			++(this->generation);
+			next = 0;
+		}
+		this->position = 0;
+	}
+
+	reference operator*() const {
+		return this->generations[this->generation]->buckets[this->position];
+	}
+
+	pointer operator->() const {
+		return &(this->generations[this->generation]->buckets[this->position]);
+	}
+
+	hashTableIterator &operator++() {
+		advance();
+		return *this;
+	}
+
+	hashTableIterator operator++(int) {
+		hashTableIterator before = *this;
+		advance();
+		return before;
+	}
+
+	bool operator==(const hashTableIterator &other) const {
+		return this->generation == other.generation && this->position == other.position;
+	}
+
+	bool operator!=(const hashTableIterator &other) const {
+		return !(*this == other);
+	}
+};
+
+template <typename K, typename V, typename Hash = hashMixer<K>>
+class hashTable {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	hashTable class with keys of type K and values V.
+	Enforces open addressing over chaining methods, and uses sub-struct Buckets to contain entries.
+	The goal of a hashtable is to insert, find, and remove at O(1) time like an array.
+
+	We use a hashing function to change a key, K, into an integer index for the table, which allows us to access [hypothetically] ~O(1).
+	Sometimes hash functions do not provide a perfect hash :: h(K) may == h(K2) even if K != k2...
+		... Which is why we probe for the next free slot, and thus worst time is O(n) but very unlikely.
+
+	Each slot has a 1-byte tag in control, holding 7 bits of the hash when full. Most mismatching slots are
+	rejected from the tag alone, and the grouped strategy rejects 16 of them with a single SSE2 compare.
+
+	The table grows by doubling once 7/8 of the slots are full or deleted. Growing doesn't rehash everything
+	at once: the old slots are kept as "retiring", and every insert and remove moves a few of them over.
+	Until the retiring slots are drained, lookups check both generations.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	private:
+		bucketArray<K, V> table;
+		bucketArray<K, V> retiring; // The previous generation while it is being migrated, else capacity 0.
+		int migrated; // Retiring slots that have already been moved over.
+		const int size; // intialized size, the table starts with at least this many slots.
+		int entries; // Actual used values in the table.
+		const probeStrategy strategy;
+		Hash hasher;
+		typename std::conditional<std::is_same<K, arenaString>::value, stringArena, noArena>::type arena; // Owns arenaString key bytes.
+
+		enum : int { migrationStep = 16 }; // Retiring slots moved per insert / remove.
+
+#if HASH_TABLE_STATS
+		probeRecorders recorded;
+#endif
+
+		void recordProbe(probeRecorder probeRecorders::*histogram, const int length) {
+#if HASH_TABLE_STATS
+			(this->recorded.*histogram).record(length);
+#else
+			(void)histogram;
+			(void)length;
+#endif
+		}
+
+		template <typename Q>
+		std::uint64_t hash(const Q &key) const {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Full width hash of a key. The home slot and the 7-bit tag are both taken from it.
+			Q is K, or with a transparent Hash anything it hashes the same way (std::string_view for strings).
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			return static_cast<std::uint64_t>(this->hasher(key));
+		}
+
+		static int homeSlot(const bucketArray<K, V> &slots, const std::uint64_t hashed) {
+			return homeSlotOf(hashed, slots.shift);
+		}
+
+		static int capacityFor(const int entries) {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Smallest power of two capacity, at least one group, that holds entries below the 7/8 load limit.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			int capacity = controlGroup::width;
+			while (static_cast<long long>(capacity) * 7 < static_cast<long long>(entries) * 8) {
+				capacity *= 2;
+			}
+			return capacity;
+		}
+
+		template <typename Q>
+		int findSlot(const bucketArray<K, V> &slots, const Q &key, const std::uint64_t hashed) const {
+			int probed;
+			return findSlot(slots, key, hashed, probed);
+		}
+
+		template <typename Q>
+		int findSlot(const bucketArray<K, V> &slots, const Q &key, const std::uint64_t hashed, int &probed) const {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Return the slot of slots holding key, or -1 if it isn't there.
+			probed is set to the number of slots (or groups) examined, for the probe length statistics.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			probed = 0;
+			if (slots.capacity == 0) {
+				return -1;
+			}
+
+			if (this->strategy == probeStrategy::grouped) {
+				return findInGroups(slots.control.data(), slots.capacity, slots.shift, hashed,
+					[&](const int slot) { return slots.buckets[slot].key == key; }, probed);
+			}
+
+			const std::int8_t tag = tagOf(hashed);
+			const int mask = slots.capacity - 1;
+			const bool robinHood = (slots.distance != nullptr);
+			int position = homeSlot(slots, hashed);
+			while (probed < slots.capacity) {
+				++probed;
+				if (slots.control[position] == controlGroup::empty) {
+					return -1;
+				}
+				else if (robinHood && slots.control[position] >= 0 && slots.distance[position] < probed - 1) {
+					return -1; // key would have taken this slot from an entry closer to home.
+				}
+				else if (slots.control[position] == tag && slots.buckets[position].key == key) {
+					return position;
+				}
+				position = (position + 1) & mask;
+			}
+			return -1;
+		}
+
+		int findFreeSlot(const bucketArray<K, V> &slots, const std::uint64_t hashed) {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Return the first empty or deleted slot on the probe sequence of hashed.
+			The load limit guarantees there is one.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			const int mask = slots.capacity - 1;
+
+			if (this->strategy == probeStrategy::grouped) {
+				return findFreeInGroups(slots.control.data(), slots.capacity, slots.shift, hashed);
+			}
+
+			int position = homeSlot(slots, hashed);
+			while (slots.control[position] >= 0) {
+				position = (position + 1) & mask;
+			}
+			return position;
+		}
+
+		void place(bucketArray<K, V> &slots, const std::uint64_t hashed, Bucket<K, V> &&entry) {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Store an entry known not to be in slots. Reusing a deleted slot doesn't change used.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			if (slots.distance != nullptr) {
+				placeRobinHood(slots, hashed, std::move(entry));
+				return;
+			}
+
+			const int position = findFreeSlot(slots, hashed);
+			if (slots.control[position] == controlGroup::empty) {
+				++(slots.used);
+			}
+			new (&slots.buckets[position]) Bucket<K, V>(std::move(entry));
+			slots.control[position] = tagOf(hashed);
+		}
+
+		void placeRobinHood(bucketArray<K, V> &slots, const std::uint64_t hashed, Bucket<K, V> &&entry) {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Walk from the home slot carrying the entry. Whenever the resident entry is closer to its home
+			... than the carried one, they trade places and the walk continues with the evicted entry.
+			The current generation never holds tombstones in this strategy, so the walk ends on an empty slot.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			const int mask = slots.capacity - 1;
+			Bucket<K, V> carried(std::move(entry));
+			std::int8_t carriedTag = tagOf(hashed);
+			std::int32_t carriedDistance = 0;
+			int position = homeSlot(slots, hashed);
+
+			while (slots.control[position] != controlGroup::empty) {
+				if (slots.distance[position] < carriedDistance) {
+					std::swap(carried, slots.buckets[position]);
+					std::swap(carriedTag, slots.control[position]);
+					std::swap(carriedDistance, slots.distance[position]);
+				}
+				position = (position + 1) & mask;
+				++carriedDistance;
+			}
+			new (&slots.buckets[position]) Bucket<K, V>(std::move(carried));
+			slots.control[position] = carriedTag;
+			slots.distance[position] = carriedDistance;
+			++(slots.used);
+		}
+
+		void shiftBack(bucketArray<K, V> &slots, int position) {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Robin Hood removal. Entries after the removed one move back a slot until one is already at home
+			... or the cluster ends, so no tombstone is left and every distance stays exact.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			const int mask = slots.capacity - 1;
+			slots.buckets[position].~Bucket<K, V>();
+			int next = (position + 1) & mask;
+
+			while (slots.control[next] >= 0 && slots.distance[next] > 0) {
+				new (&slots.buckets[position]) Bucket<K, V>(std::move(slots.buckets[next]));
+				slots.buckets[next].~Bucket<K, V>();
+				slots.control[position] = slots.control[next];
+				slots.distance[position] = slots.distance[next] - 1;
+				position = next;
+				next = (next + 1) & mask;
+			}
+			slots.control[position] = controlGroup::empty;
+			--(slots.used);
+		}
+
+		void erase(bucketArray<K, V> &slots, const int position) {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Mark a slot as "once used but now empty" so later probes continue past it.
+			In the grouped strategy, a group that still has an empty tag was never probed past,
+			... so the slot can go straight back to empty instead of becoming a tombstone.
+			Retiring slots always use tombstones, even with robinHood, so migration can't shift entries
+			... back behind its cursor.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			const int base = position & ~(controlGroup::width - 1);
+			slots.buckets[position].~Bucket<K, V>();
+			if (this->strategy == probeStrategy::grouped && controlGroup::matchEmpty(&slots.control[base])) {
+				slots.control[position] = controlGroup::empty;
+				--(slots.used);
+			}
+			else {
+				slots.control[position] = controlGroup::deleted;
+			}
+		}
+
+		void migrate(int budget) {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Move up to budget retiring slots into the current table. Moved slots are left deleted, so probes
+			... into the retiring slots still walk past them. The retiring slots are freed once drained.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			while (budget > 0 && this->migrated < this->retiring.capacity) {
+				const int position = this->migrated;
+				if (this->retiring.control[position] >= 0) {
+					Bucket<K, V> &entry = this->retiring.buckets[position];
+					place(this->table, hash(entry.key), std::move(entry));
+					entry.~Bucket<K, V>();
+					this->retiring.control[position] = controlGroup::deleted;
+				}
+				++(this->migrated);
+				--budget;
+			}
+			if (this->retiring.capacity != 0 && this->migrated == this->retiring.capacity) {
+				this->retiring = bucketArray<K, V>();
+				this->migrated = 0;
+			}
+		}
+
+		void growIfNeeded() {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Before an insertion, start a new generation if one more slot would pass the 7/8 load limit.
+			Mostly tombstones: rebuild at the same capacity. Mostly live entries: double the capacity.
+			A migration still in progress is finished first, there are never more than two generations.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			if (static_cast<long long>(this->table.used + 1) * 8 <= static_cast<long long>(this->table.capacity) * 7) {
+				return;
+			}
+			migrate(this->retiring.capacity);
+
+			int capacity = this->table.capacity;
+			if (static_cast<long long>(this->entries) * 16 >= static_cast<long long>(capacity) * 7) {
+				capacity *= 2;
+			}
+			this->retiring = std::move(this->table);
+			this->table = bucketArray<K, V>(capacity, this->strategy == probeStrategy::robinHood);
+			this->migrated = 0;
+		}
+
+		template <typename Q>
+		void removeKey(const Q &key) {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Remove key from whichever generation holds it.
+			O(1) if no collision, else possible O(n).
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			migrate(migrationStep);
+			const std::uint64_t hashed = hash(key);
+
+			int probed = 0, retiringProbed = 0;
+			int position = findSlot(this->table, key, hashed, probed);
+			if (position != -1) {
+				recordProbe(&probeRecorders::removeProbes, probed);
+				if (this->strategy == probeStrategy::robinHood) {
+					shiftBack(this->table, position);
+				}
+				else {
+					erase(this->table, position);
+				}
+				--(this->entries);
+				return;
+			}
+
+			position = findSlot(this->retiring, key, hashed, retiringProbed);
+			recordProbe(&probeRecorders::removeProbes, probed + retiringProbed);
+			if (position != -1) {
+				erase(this->retiring, position);
+				--(this->entries);
+			}
+			return; // Value isn't in the table.
+		}
+
+		template <typename Q>
+		V atKey(const Q &key) {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Returns the value at an index in the hash table, K.
+			If the value doesn't exist, throws keyNotFound.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			V *value = findKey(key);
+			if (value == nullptr) {
+				throw keyNotFound(); // We've reached the end of the probe, doesn't exist.
+			}
+			return *value;
+		}
+
+		template <typename Q>
+		V *findKey(const Q &key) {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Non-throwing lookup. Returns a pointer to the value of key, or nullptr if the key doesn't exist.
+			Lookups never migrate, so the pointer is valid until the next insert or remove.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			return findHashed(key, hash(key));
+		}
+
+		template <typename Q>
+		V *findHashed(const Q &key, const std::uint64_t hashed) {
+			int probed = 0, retiringProbed = 0;
+			int position = findSlot(this->table, key, hashed, probed);
+			if (position != -1) {
+				recordProbe(&probeRecorders::atProbes, probed);
+				return &(this->table.buckets[position].value);
+			}
+
+			position = findSlot(this->retiring, key, hashed, retiringProbed);
+			recordProbe(&probeRecorders::atProbes, probed + retiringProbed);
+			if (position != -1) {
+				return &(this->retiring.buckets[position].value);
+			}
+			return nullptr;
+		}
+
+		template <typename Q>
+		const V *lookup(const Q &key) const {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			findKey() for a const table: the same probe, but nothing is recorded, so it only ever reads the table.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			const std::uint64_t hashed = hash(key);
+			int position = findSlot(this->table, key, hashed);
+			if (position != -1) {
+				return &(this->table.buckets[position].value);
+			}
+			position = findSlot(this->retiring, key, hashed);
+			if (position != -1) {
+				return &(this->retiring.buckets[position].value);
+			}
+			return nullptr;
+		}
+
+		static void prefetch(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(address);
+#elif HASH_TABLE_SSE2
+			_mm_prefetch(static_cast<const char *>(address), _MM_HINT_T0);
+#else
+			(void)address;
+#endif
+		}
+
+	public:
+
+		hashTable(const int sizeParam, const probeStrategy strategyParam = probeStrategy::linear, const Hash &hashParam = Hash()) :
+			table(capacityFor(sizeParam), strategyParam == probeStrategy::robinHood), migrated(0), size(sizeParam), entries(0),
+			strategy(strategyParam), hasher(hashParam) {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Default initialization, initialization list lets us construct const members.
+			The table starts with room for sizeParam entries and grows as needed.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+		}
+
+		void insert(const K &key, const V &value) {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Insert to the bucket. O(1) time if no collision. Else, possible O(n) time.
+			If the table passes its load limit, a bigger generation is started and filled incrementally.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			migrate(migrationStep);
+			const std::uint64_t hashed = hash(key);
+
+			int probed = 0, retiringProbed = 0;
+			if (findSlot(this->table, key, hashed, probed) != -1 || findSlot(this->retiring, key, hashed, retiringProbed) != -1) {
+				return; // We've already inserted this entry.
+			}
+			recordProbe(&probeRecorders::insertProbes, probed + retiringProbed);
+
+			growIfNeeded();
+			place(this->table, hashed, Bucket<K, V>(this->arena.intern(key), value));
+			++(this->entries);
+		}
+
+		template <typename Update>
+		void upsert(const K &key, Update update, const V &initial = V()) {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Call update(value) on the value of key, in place. If key isn't in the table, it is inserted with a
+			... copy of initial, and update runs on that before it is stored. One probe either way, where
+			... at() + remove() + insert() would take three. E.g. counting: upsert(word, [](int &n) { ++n; }).
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			migrate(migrationStep);
+			const std::uint64_t hashed = hash(key);
+
+			int probed = 0, retiringProbed = 0;
+			int position = findSlot(this->table, key, hashed, probed);
+			if (position != -1) {
+				recordProbe(&probeRecorders::insertProbes, probed);
+				update(this->table.buckets[position].value);
+				return;
+			}
+			position = findSlot(this->retiring, key, hashed, retiringProbed);
+			recordProbe(&probeRecorders::insertProbes, probed + retiringProbed);
+			if (position != -1) {
+				update(this->retiring.buckets[position].value);
+				return;
+			}
+
+			Bucket<K, V> entry(this->arena.intern(key), initial);
+			update(entry.value);
+			growIfNeeded();
+			place(this->table, hashed, std::move(entry));
+			++(this->entries);
+		}
+
+		void remove(const K &key) {
+			removeKey(key);
+		}
+
+		V at(const K &key) {
+			return atKey(key);
+		}
+
+		V *find(const K &key) {
+			return findKey(key);
+		}
+
+		bool contains(const K &key) {
+			return (findKey(key) != nullptr);
+		}
+
+		V at(const K &key) const {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Const overloads of at(), find() and contains(). They never write to the table, not even the probe
+			... histograms of a HASH_TABLE_STATS build, so they are the ones for readers sharing a lock.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			const V *value = lookup(key);
+			if (value == nullptr) {
+				throw keyNotFound();
+			}
+			return *value;
+		}
+
+		const V *find(const K &key) const {
+			return lookup(key);
+		}
+
+		bool contains(const K &key) const {
+			return (lookup(key) != nullptr);
+		}
+
+		template <typename Q, typename H = Hash, typename = typename H::is_transparent>
+		void remove(const Q &key) {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			Heterogeneous overloads, only available when Hash declares is_transparent (the default for std::string
+			... and arenaString keys). A std::string_view or string literal is hashed and compared as it is,
+			... so probing from a parser never allocates a std::string.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			removeKey(key);
+		}
+
+		template <typename Q, typename H = Hash, typename = typename H::is_transparent>
+		V at(const Q &key) {
+			return atKey(key);
+		}
+
+		template <typename Q, typename H = Hash, typename = typename H::is_transparent>
+		V *find(const Q &key) {
+			return findKey(key);
+		}
+
+		template <typename Q, typename H = Hash, typename = typename H::is_transparent>
+		bool contains(const Q &key) {
+			return (findKey(key) != nullptr);
+		}
+
+		void findBatch(const K *keys, const int count, V **results) {
+
+			/// ------------------------------------------------------------------------------------ ///
+			/*
+			find() for count keys at once, results[i] is the value pointer (or nullptr) for keys[i].
+			Keys go through in blocks: first every key of the block is hashed and the tags and bucket of its
+			... home slot are prefetched, then the block is resolved. The cache misses of a block overlap
+			... instead of being paid one after another, which matters once the table is bigger than the cache.
+			*/
+			/// ------------------------------------------------------------------------------------ ///
+
+			const int block = 16;
+			std::uint64_t hashes[block];
+
+			for (int start = 0; start < count; start += block) {
+				const int end = (start + block < count) ? start + block : count;
+				for (int i = start; i < end; ++i) {
+					hashes[i - start] = hash(keys[i]);
+					int home = homeSlot(this->table, hashes[i - start]);
+					if (this->strategy == probeStrategy::grouped) {
+						home &= ~(controlGroup::width - 1);
+					}
+					prefetch(&this->table.control[home]);
+					prefetch(&this->table.buckets[home]);
+					if (this->table.distance != nullptr) {
+						prefetch(&this->table.distance[home]);
+					}
+				}
+				for (int i = start; i < end; ++i) {
+					results[i] = findHashed(keys[i], hashes[i - start]);
+				}
+			}
+		}
+
+			int howManyEntries() {
+				return this->entries;
+			}
+
+			int capacity() {
+				return this->table.capacity;
+			}
+
+			bool isRehashing() {
+				return (this->retiring.capacity != 0);
+			}
+
+			bool isEmpty() {
+				return (this->entries == 0);
+			}
+
+			long long memoryUsage() {
+
+				/// ------------------------------------------------------------------------------------ ///
+				/*
+				Bytes held by the slot arrays of both generations: a Bucket and a tag per slot, plus the
+				... Robin Hood distances. Memory owned by the keys and values themselves isn't included.
+				*/
+				/// ------------------------------------------------------------------------------------ ///
+
+				long long bytes = 0;
+				const bucketArray<K, V> *generations[] = { &this->table, &this->retiring };
+				for (const bucketArray<K, V> *slots : generations) {
+					const long long perSlot = sizeof(Bucket<K, V>) + 1 + ((slots->distance != nullptr) ? sizeof(std::int32_t) : 0);
+					bytes += perSlot * slots->capacity;
+				}
+				return bytes;
+			}
+
+			typedef hashTableIterator<K, V> iterator;
+
+			iterator begin() {
+				return iterator(&this->table, &this->retiring, 0);
+			}
+
+			iterator end() {
+				return iterator(&this->table, &this->retiring, 2);
+			}
+
+			template <typename Visitor>
+			void forEach(Visitor visit) {
+
+				/// ------------------------------------------------------------------------------------ ///
+				/*
+				Call visit(key, value) once for every entry, including entries not yet migrated.
+				The table must not be changed while it is being visited.
+				*/
+				/// ------------------------------------------------------------------------------------ ///
+
+				for (Bucket<K, V> &entry : *this) {
+					visit(entry.key, entry.value);
+				}
+			}
+
+			void reserve(const int expected) {
+
+				/// ------------------------------------------------------------------------------------ ///
+				/*
+				Make room for expected entries in total, so inserting up to that many never grows the table.
+				Rebuilds at once (finishing any migration) if the table is too small, else does nothing.
+				Call it before a large load: one O(n) rebuild now instead of log(n) growths along the way.
+				*/
+				/// ------------------------------------------------------------------------------------ ///
+
+				const int needed = capacityFor(std::max(expected, this->entries));
+				if (needed <= this->table.capacity && !isRehashing()) {
+					return;
+				}
+				migrate(this->retiring.capacity);
+				if (needed <= this->table.capacity) {
+					return;
+				}
+				this->retiring = std::move(this->table);
+				this->table = bucketArray<K, V>(needed, this->strategy == probeStrategy::robinHood);
+				this->migrated = 0;
+				migrate(this->retiring.capacity);
+			}
+
+			template <typename Iterator>
+			void insertBulk(Iterator first, Iterator last) {
+
+				/// ------------------------------------------------------------------------------------ ///
+				/*
+				Insert every (key, value) pair in [first, last), e.g. from a std::vector<std::pair<K, V>> or a std::map.
+				With forward iterators the range is counted first and the table reserved once, so none of the
+				... insertions grow it. Keys already in the table, or repeated in the range, keep their first value.
+				*/
+				/// ------------------------------------------------------------------------------------ ///
+
+				typedef typename std::iterator_traits<Iterator>::iterator_category category;
+				if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+					const long long incoming = static_cast<long long>(std::distance(first, last));
+					reserve(static_cast<int>(std::min<long long>(this->entries + incoming, 0x3FFFFFFF)));
+				}
+				for (; first != last; ++first) {
+					insert(first->first, first->second);
+				}
+			}
+
+			probeStats probeStatistics() {
+
+				/// ------------------------------------------------------------------------------------ ///
+				/*
+				Scan both generations and measure how far each entry sits from its home slot. O(capacity).
+				*/
+				/// ------------------------------------------------------------------------------------ ///
+
+				probeStats stats = { 0, 0.0, 0.0, 0 };
+				double sum = 0, sumOfSquares = 0;
+
+				const bucketArray<K, V> *generations[] = { &this->table, &this->retiring };
+				for (const bucketArray<K, V> *slots : generations) {
+					for (int i = 0; i < slots->capacity; ++i) {
+						if (slots->control[i] < 0) {
+							continue;
+						}
+						int home = homeSlot(*slots, hash(slots->buckets[i].key));
+						if (this->strategy == probeStrategy::grouped) {
+							home &= ~(controlGroup::width - 1);
+						}
+						const int length = (i - home) & (slots->capacity - 1);
+						++(stats.entries);
+						sum += length;
+						sumOfSquares += static_cast<double>(length) * length;
+						if (length > stats.longestProbe) {
+							stats.longestProbe = length;
+						}
+					}
+				}
+				if (stats.entries != 0) {
+					stats.meanProbeLength = sum / stats.entries;
+					stats.probeLengthVariance = sumOfSquares / stats.entries - stats.meanProbeLength * stats.meanProbeLength;
+				}
+				return stats;
+			}
+
+			tableStats tableStatistics() {
+
+				/// ------------------------------------------------------------------------------------ ///
+				/*
+				Measure occupancy, tombstones and the longest cluster with one scan of the tags, O(capacity),
+				... and copy out the probe histograms recorded so far.
+				*/
+				/// ------------------------------------------------------------------------------------ ///
+
+#if HASH_TABLE_STATS
+				tableStats stats = tableStats();
+				stats.recordsProbes = true;
+				stats.insertProbes = this->recorded.insertProbes.snapshot();
+				stats.atProbes = this->recorded.atProbes.snapshot();
+				stats.removeProbes = this->recorded.removeProbes.snapshot();
+#else
+				tableStats stats = tableStats();
+				stats.recordsProbes = false;
+#endif
+				stats.entries = this->entries;
+				stats.capacity = this->table.capacity;
+				stats.loadFactor = static_cast<double>(this->entries) / this->table.capacity;
+				stats.tombstones = 0;
+				stats.pendingMigration = 0;
+				stats.longestCluster = 0;
+
+				// Clusters wrap around the end, so start counting just after an empty slot.
+				int start = 0;
+				while (start < this->table.capacity && this->table.control[start] != controlGroup::empty) {
+					++start;
+				}
+				int run = 0;
+				for (int i = 1; i <= this->table.capacity; ++i) {
+					const std::int8_t tag = this->table.control[(start + i) & (this->table.capacity - 1)];
+					if (tag == controlGroup::deleted) {
+						++(stats.tombstones);
+					}
+					run = (tag == controlGroup::empty) ? 0 : run + 1;
+					stats.longestCluster = std::max(stats.longestCluster, run);
+				}
+				for (int i = this->migrated; i < this->retiring.capacity; ++i) {
+					if (this->retiring.control[i] >= 0) {
+						++(stats.pendingMigration);
+					}
+				}
+				return stats;
+			}
+
+			void print() {
+				std::cout << "\n----------------------------\n" << \
+					"Hash Table Starting Size: " << this->size << " | Capacity: " << this->table.capacity << "\n";
+				for (int i = 0; i < this->table.capacity; ++i) {
+					if (this->table.control[i] >= 0) {
+						this->table.buckets[i].print();
+					}
+				}
+				if (isRehashing()) {
+					std::cout << "Not yet migrated:\n";
+					for (int i = this->migrated; i < this->retiring.capacity; ++i) {
+						if (this->retiring.control[i] >= 0) {
+							this->retiring.buckets[i].print();
+						}
+					}
+				}
+				std::cout << "----------------------------\n";
+			}
+};
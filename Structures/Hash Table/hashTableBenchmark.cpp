@@ -0,0 +1,371 @@
+/// ------------------------------------------------------------------------------------ ///
+/*
+Timing harness for the hash table. Not a demo, build it with optimizations on:
+g++ -O2 -std=c++17 hashTableBenchmark.cpp -o hashTableBenchmark
+Pass the number of keys as the first argument (default 1,000,000).
+Add -DHASH_TABLE_STATS=1 to also print probe length histograms, and to see what recording them costs.
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "cuckooTable.h"
+#include "denseHashTable.h"
+#include "hashTable.h"
+
+double millisecondsSince(const std::chrono::steady_clock::time_point &start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const std::string &name, const std::string &operation, const double milliseconds, const int operations) {
+	std::cout << name << " | " << operation << ": " << milliseconds << " ms, " << \
+		(milliseconds * 1000000.0 / operations) << " ns/op\n";
+}
+
+template <typename Table>
+void benchmarkStrategy(const std::string &name, Table &H, const std::vector<int> &keys,
+	const std::vector<int> &missing, const int count) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Time inserting the first count keys into H, looking each one up again, and looking up keys that were
+	... never inserted. H is sized by the caller so it doesn't grow during the run.
+	Lookups use find() so a miss isn't timed as the cost of throwing keyNotFound.
+	The checksum keeps the compiler from dropping the lookups.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; ++i) {
+		H.insert(keys[i], keys[i]);
+	}
+	report(name, "insert", millisecondsSince(start), count);
+
+	long long checksum = 0;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; ++i) {
+		checksum += *H.find(keys[i]);
+	}
+	report(name, "hit   ", millisecondsSince(start), count);
+
+	int misses = 0;
+	start = std::chrono::steady_clock::now();
+	for (int key : missing) {
+		if (H.find(key) == nullptr) {
+			++misses;
+		}
+	}
+	report(name, "miss  ", millisecondsSince(start), static_cast<int>(missing.size()));
+	std::cout << "(checksum " << checksum << ", misses " << misses << ")\n";
+}
+
+void benchmarkGrowth(const std::string &name, const probeStrategy strategy, const std::vector<int> &keys) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Insert every key into a table that starts at one group and has to grow the whole way.
+	The slowest single insertion shows whether growing ever stops the world to rehash.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	hashTable<int, int> H(16, strategy);
+	double slowest = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (int key : keys) {
+		const auto before = std::chrono::steady_clock::now();
+		H.insert(key, key);
+		const double took = millisecondsSince(before);
+		if (took > slowest) {
+			slowest = took;
+		}
+	}
+	report(name, "grow  ", millisecondsSince(start), static_cast<int>(keys.size()));
+	std::cout << "(capacity " << H.capacity() << ", slowest insert " << slowest << " ms)\n";
+}
+
+void benchmarkChurn(const std::string &name, const probeStrategy strategy, const std::vector<int> &keys) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Keep the table at a steady size while replacing its keys: each round removes the oldest key and inserts
+	... a new one. Tombstone based removal keeps lengthening probes, backward shifting doesn't.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	const int live = static_cast<int>(keys.size()) / 4;
+	hashTable<int, int> H(live, strategy);
+	for (int i = 0; i < live; ++i) {
+		H.insert(keys[i], i);
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = live; i < static_cast<int>(keys.size()); ++i) {
+		H.remove(keys[i - live]);
+		H.insert(keys[i], i);
+	}
+	report(name, "churn ", millisecondsSince(start), static_cast<int>(keys.size()) - live);
+	H.probeStatistics().print();
+	H.tableStatistics().print();
+}
+
+struct identityHash {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	The key itself as its hash, what std::hash<int> usually is. Shows what the default mixer buys.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::uint64_t operator()(const int key) const {
+		return static_cast<std::uint64_t>(static_cast<unsigned int>(key));
+	}
+};
+
+template <typename Hash>
+void benchmarkStrided(const std::string &name, const int count, const int stride) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Row ID like keys: 0, stride, 2 * stride, ... Inserted and then looked up with the grouped strategy.
+	Multiply-shift spreads the identity hash over the slots, but every key still gets the same 7-bit tag.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	hashTable<int, int, Hash> H(count, probeStrategy::grouped);
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; ++i) {
+		H.insert(i * stride, i);
+	}
+	report(name, "insert", millisecondsSince(start), count);
+
+	long long checksum = 0;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; ++i) {
+		checksum += *H.find(i * stride);
+	}
+	report(name, "hit   ", millisecondsSince(start), count);
+	H.probeStatistics().print();
+	std::cout << "(checksum " << checksum << ")\n";
+}
+
+void benchmarkBatch(const std::string &name, const probeStrategy strategy, const std::vector<int> &keys) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Look every key up again in a shuffled order, one find() at a time and then through findBatch().
+	Only shows a difference once the table is well past the size of the cache.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	hashTable<int, int> H(static_cast<int>(keys.size()), strategy);
+	for (int key : keys) {
+		H.insert(key, key);
+	}
+	std::vector<int> order(keys);
+	std::shuffle(order.begin(), order.end(), std::mt19937(7));
+	const int count = static_cast<int>(order.size());
+
+	long long checksum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int key : order) {
+		checksum += *H.find(key);
+	}
+	report(name, "single", millisecondsSince(start), count);
+
+	std::vector<int *> results(count);
+	start = std::chrono::steady_clock::now();
+	H.findBatch(order.data(), count, results.data());
+	for (int *value : results) {
+		checksum -= *value;
+	}
+	report(name, "batch ", millisecondsSince(start), count);
+	std::cout << "(checksum " << checksum << ", 0 if both agree)\n";
+}
+
+void benchmarkBulk(const std::string &name, const probeStrategy strategy, const std::vector<int> &keys) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Load every key into a table that starts small, one insert() at a time and then with insertBulk(),
+	... which reserves once and never grows. Then walk the loaded table with its iterators.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::vector<std::pair<int, int>> pairs;
+	pairs.reserve(keys.size());
+	for (int key : keys) {
+		pairs.push_back({ key, key });
+	}
+
+	hashTable<int, int> single(16, strategy);
+	auto start = std::chrono::steady_clock::now();
+	for (const std::pair<int, int> &entry : pairs) {
+		single.insert(entry.first, entry.second);
+	}
+	report(name, "single", millisecondsSince(start), static_cast<int>(pairs.size()));
+
+	hashTable<int, int> bulk(16, strategy);
+	start = std::chrono::steady_clock::now();
+	bulk.insertBulk(pairs.begin(), pairs.end());
+	report(name, "bulk  ", millisecondsSince(start), static_cast<int>(pairs.size()));
+
+	long long checksum = 0;
+	start = std::chrono::steady_clock::now();
+	for (Bucket<int, int> &entry : bulk) {
+		checksum += entry.value;
+	}
+	report(name, "walk  ", millisecondsSince(start), bulk.howManyEntries());
+	std::cout << "(checksum " << checksum << ")\n";
+}
+
+template <typename Table, typename V>
+void benchmarkLayout(const std::string &name, Table &H, const std::vector<int> &keys, const std::vector<int> &missing, const V &value) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Fill H with every key, then report the bytes its arrays hold per entry and time hits and misses.
+	Misses only read tags and keys, so they show what keeping the values elsewhere does for the cache.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	for (int key : keys) {
+		H.insert(key, value);
+	}
+	std::cout << name << " | bytes per entry: " << static_cast<double>(H.memoryUsage()) / H.howManyEntries() << "\n";
+
+	long long found = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int key : keys) {
+		found += (H.find(key) != nullptr);
+	}
+	report(name, "hit   ", millisecondsSince(start), static_cast<int>(keys.size()));
+
+	start = std::chrono::steady_clock::now();
+	for (int key : missing) {
+		found += (H.find(key) != nullptr);
+	}
+	report(name, "miss  ", millisecondsSince(start), static_cast<int>(missing.size()));
+	std::cout << "(found " << found << ")\n";
+}
+
+void benchmarkCounting(const std::string &name, const probeStrategy strategy, const std::vector<int> &keys) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Count how often each of a few thousand keys occurs in a stream, first with at() + remove() + insert()
+	... (three probes per event), then with upsert() (one).
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	const int distinct = 4096;
+	hashTable<int, int> H(distinct, strategy);
+	auto start = std::chrono::steady_clock::now();
+	for (int key : keys) {
+		const int *count = H.find(key % distinct);
+		const int next = (count == nullptr) ? 1 : *count + 1;
+		H.remove(key % distinct);
+		H.insert(key % distinct, next);
+	}
+	report(name, "3 probes", millisecondsSince(start), static_cast<int>(keys.size()));
+
+	hashTable<int, int> U(distinct, strategy);
+	start = std::chrono::steady_clock::now();
+	for (int key : keys) {
+		U.upsert(key % distinct, [](int &count) { ++count; });
+	}
+	report(name, "upsert  ", millisecondsSince(start), static_cast<int>(keys.size()));
+	std::cout << "(counts agree: " << (*H.find(0) == *U.find(0)) << ")\n";
+}
+
+int main(int argc, char **argv) {
+
+	const int count = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+	std::mt19937 generator(20181015);
+	std::uniform_int_distribution<int> distribution(0, (1 << 30) - 1);
+
+	// Even keys are inserted, odd keys are guaranteed misses.
+	std::vector<int> keys(count), missing(count / 4);
+	for (int &key : keys) {
+		key = distribution(generator) * 2;
+	}
+	for (int &key : missing) {
+		key = distribution(generator) * 2 + 1;
+	}
+
+	// Capacities are powers of two, so the load factor is set by how many of the keys go in.
+	int capacity = 16;
+	while (capacity < count) {
+		capacity *= 2;
+	}
+	const double loads[] = { 0.5, 0.85 };
+	for (double load : loads) {
+		const int inserted = std::min(count, static_cast<int>(capacity * load));
+		std::cout << "\n" << inserted << " keys in " << capacity << " slots, load factor " << load << "\n";
+		hashTable<int, int> linear(capacity / 8 * 7, probeStrategy::linear);
+		hashTable<int, int> grouped(capacity / 8 * 7, probeStrategy::grouped);
+		hashTable<int, int> robin(capacity / 8 * 7, probeStrategy::robinHood);
+		cuckooTable<int, int> cuckoo(capacity / 10 * 9);
+		benchmarkStrategy("linear ", linear, keys, missing, inserted);
+		benchmarkStrategy("grouped", grouped, keys, missing, inserted);
+		benchmarkStrategy("robin  ", robin, keys, missing, inserted);
+		benchmarkStrategy("cuckoo ", cuckoo, keys, missing, inserted);
+	}
+
+	std::cout << "\n" << count << " keys, growing from 16 slots\n";
+	benchmarkGrowth("linear ", probeStrategy::linear, keys);
+	benchmarkGrowth("grouped", probeStrategy::grouped, keys);
+	benchmarkGrowth("robin  ", probeStrategy::robinHood, keys);
+
+	const int strided = std::min(count, 200000);
+	std::cout << "\n" << strided << " keys strided by 1024\n";
+	benchmarkStrided<identityHash>("identity", strided, 1024);
+	benchmarkStrided<hashMixer<int>>("mixer   ", strided, 1024);
+
+	std::cout << "\n" << count << " keys looked up in a shuffled order\n";
+	benchmarkBatch("linear ", probeStrategy::linear, keys);
+	benchmarkBatch("grouped", probeStrategy::grouped, keys);
+	benchmarkBatch("robin  ", probeStrategy::robinHood, keys);
+
+	std::cout << "\n" << count << " keys loaded one by one, then in bulk\n";
+	benchmarkBulk("linear ", probeStrategy::linear, keys);
+	benchmarkBulk("grouped", probeStrategy::grouped, keys);
+	benchmarkBulk("robin  ", probeStrategy::robinHood, keys);
+
+	std::cout << "\n" << count << " keys, int values, in each layout\n";
+	{
+		hashTable<int, int> buckets(16, probeStrategy::grouped);
+		denseHashTable<int, int> inSlots(16, valueLayout::inSlots);
+		denseHashTable<int, int> outOfLine(16, valueLayout::outOfLine);
+		benchmarkLayout("buckets  ", buckets, keys, missing, 0);
+		benchmarkLayout("inSlots  ", inSlots, keys, missing, 0);
+		benchmarkLayout("outOfLine", outOfLine, keys, missing, 0);
+	}
+	std::cout << "\n" << count << " keys, std::string values, in each layout\n";
+	{
+		const std::string value = "Pokemon";
+		hashTable<int, std::string> buckets(16, probeStrategy::grouped);
+		denseHashTable<int, std::string> inSlots(16, valueLayout::inSlots);
+		denseHashTable<int, std::string> outOfLine(16, valueLayout::outOfLine);
+		benchmarkLayout("buckets  ", buckets, keys, missing, value);
+		benchmarkLayout("inSlots  ", inSlots, keys, missing, value);
+		benchmarkLayout("outOfLine", outOfLine, keys, missing, value);
+	}
+
+	std::cout << "\n" << count << " events counted over 4096 keys\n";
+	benchmarkCounting("linear ", probeStrategy::linear, keys);
+	benchmarkCounting("grouped", probeStrategy::grouped, keys);
+	benchmarkCounting("robin  ", probeStrategy::robinHood, keys);
+
+	std::cout << "\n" << count / 4 << " live keys, " << count - count / 4 << " remove + insert rounds\n";
+	benchmarkChurn("linear ", probeStrategy::linear, keys);
+	benchmarkChurn("grouped", probeStrategy::grouped, keys);
+	benchmarkChurn("robin  ", probeStrategy::robinHood, keys);
+	return 0;
+}
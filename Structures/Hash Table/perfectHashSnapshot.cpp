@@ -0,0 +1,96 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include "perfectHashSnapshot.h"
+
+template <typename Patch>
+bool opensPatched(const char *path, const char *copy, Patch patch) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Copy the snapshot at path to copy, let patch change the bytes (and maybe drop some), and try to open it.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::ifstream in(path, std::ios::binary);
+	std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	patch(bytes, *reinterpret_cast<snapshotHeader *>(bytes.data()));
+	std::ofstream(copy, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	try {
+		snapshotView<int, double> view(copy);
+		return true;
+	}
+	catch (const snapshotError &) {
+		return false;
+	}
+}
+
+int main()
+{
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Gain a few insights on how to snapshot a hashTable, and see a testable demo that checks the mapped snapshot
+	against the table it came from. Writes (and then deletes) a file in the current directory.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::cout << "Build a hashTable as usual, here one million pokedex style entries:\n";
+	const int count = 1000000;
+	hashTable<int, double> H(count);
+	for (int i = 0; i < count; ++i) {
+		H.insert(i * 3, i * 0.5);
+	}
+	std::cout << "Entries: " << H.howManyEntries() << "\n";
+
+	std::cout << "\nexportSnapshot() writes a minimal perfect hash and the packed keys and values to a flat file:\n";
+	const char *path = "pokedex.snapshot";
+	exportSnapshot(H, path);
+
+	const auto start = std::chrono::steady_clock::now();
+	snapshotView<int, double> S(path);
+	const double opened = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "Opening the view only maps the file: " << opened << " ms for " << S.howManyEntries() << \
+		" entries, " << S.levels() << " levels.\n";
+	std::cout << "Value of 3: " << S.at(3) << " | contains 4: " << S.contains(4) << "\n";
+
+	std::cout << "\nEvery key looked up in the view must give the table's value, and keys never inserted must miss: ";
+	bool passed = (S.howManyEntries() == H.howManyEntries());
+	for (int key = -10; key < count * 3 + 10 && passed; ++key) {
+		const double *expected = H.find(key);
+		const double *value = S.find(key);
+		passed = (expected == nullptr) ? (value == nullptr) : (value != nullptr && *value == *expected);
+	}
+	std::cout << (passed ? "passed" : "FAILED") << "\n";
+
+	std::cout << "\nA truncated file, or a header whose sections point outside the file or off a cache line, doesn't open: ";
+	const char *copy = "corrupted.snapshot";
+	typedef std::vector<char> fileBytes;
+	bool rejected = opensPatched(path, copy, [](fileBytes &, snapshotHeader &) {});
+	rejected = rejected && !opensPatched(path, copy, [](fileBytes &bytes, snapshotHeader &header) {
+		bytes.resize(bytes.size() - 4096); // Also fix up the size, so only the values run off the end.
+		header.fileSize = bytes.size();
+	});
+	rejected = rejected && !opensPatched(path, copy, [](fileBytes &, snapshotHeader &header) {
+		header.valuesOffset = ~std::uint64_t(0) / 64 * 64;
+	});
+	rejected = rejected && !opensPatched(path, copy, [](fileBytes &, snapshotHeader &header) {
+		header.keysOffset += 4;
+	});
+	rejected = rejected && !opensPatched(path, copy, [](fileBytes &, snapshotHeader &header) {
+		header.entries = header.fileSize;
+	});
+	rejected = rejected && !opensPatched(path, copy, [](fileBytes &bytes, snapshotHeader &header) {
+		reinterpret_cast<snapshotLevel *>(bytes.data() + header.levelsOffset)->bits = header.words * 64 + 64;
+	});
+	std::cout << (rejected ? "passed" : "FAILED") << "\n\n";
+
+	std::remove(path);
+	std::remove(copy);
+	passed = passed && rejected;
+	std::cin.get();
+	return passed ? 0 : 1;
+}
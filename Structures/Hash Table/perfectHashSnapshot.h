@@ -0,0 +1,427 @@
+#pragma once
+/// ------------------------------------------------------------------------------------ ///
+/*
+The following .h file includes an immutable snapshot of a hashTable: exportSnapshot() writes it to a flat file,
+... and a snapshotView maps that file into memory and answers lookups straight from the mapped pages.
+POSIX only (open / mmap).
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "hashTable.h"
+
+struct snapshotError : public std::exception {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Custom exception. Thrown when a snapshot can't be written, or a file isn't a snapshot of the expected types.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	const char *message;
+
+	snapshotError(const char *messageParam) : message(messageParam) {}
+
+	const char * what() const throw() {
+		return this->message;
+	}
+};
+
+struct snapshotHeader {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	The first bytes of a snapshot file. Every section starts at a byte offset from the start of the file,
+	... rounded up to a cache line, so each is correctly aligned wherever the file is mapped.
+
+	The file is laid out as:
+	header | level table | level bits | rank table | keys | values
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	char magic[8];
+	std::uint32_t keySize;
+	std::uint32_t valueSize;
+	std::uint64_t entries;
+	std::uint64_t levels;
+	std::uint64_t words; // 64-bit words of level bits, over all levels.
+	std::uint64_t levelsOffset;
+	std::uint64_t bitsOffset;
+	std::uint64_t ranksOffset;
+	std::uint64_t keysOffset;
+	std::uint64_t valuesOffset;
+	std::uint64_t fileSize;
+};
+
+struct snapshotLevel {
+	std::uint64_t firstBit; // Where the level starts in the level bits, always a multiple of 64.
+	std::uint64_t bits;
+};
+
+struct perfectHashIndex {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	A BBHash minimal perfect hash: maps each of n known hashes to a distinct index in [0, n).
+	Level 0 has 2n bits, and each hash picks one of them. Bits picked by exactly one hash are set, and those
+	... hashes are done. The ones that collided move on to a smaller level of their own, and so on. About
+	... 60% of the hashes settle on each level, so there are few levels and ~3 bits per entry in total.
+	A hash's index is the number of set bits before its bit (its rank), counted with the rank table, which
+	... holds the set bits before every 512-bit block.
+
+	A hash that wasn't part of the set still lands on some index, the caller has to compare keys.
+	The index only points into memory, so the same code reads the writer's vectors and a mapped file.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	enum : int { gamma = 2, wordsPerRank = 8, maxLevels = 64 };
+
+	const snapshotLevel *levels;
+	std::uint64_t levelCount;
+	const std::uint64_t *words;
+	const std::uint64_t *ranks;
+
+	static std::uint64_t position(const std::uint64_t hashed, const std::uint64_t level, const std::uint64_t bits) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		An independent bit for every level: remix the hash with the level, then scale its top 32 bits into
+		... [0, bits) with a multiply instead of a modulo. bits is at most 2^32 for any int sized table.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const std::uint64_t mixed = hashMixer<std::uint64_t>::mix(hashed ^ ((level + 1) * 0x9E3779B97F4A7C15ull));
+		return ((mixed >> 32) * bits) >> 32;
+	}
+
+	static bool bitAt(const std::uint64_t *words, const std::uint64_t bit) {
+		return (words[bit / 64] >> (bit % 64)) & 1;
+	}
+
+	std::int64_t indexOf(const std::uint64_t hashed) const {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		The index of hashed, or -1 if it found no set bit on any level.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		for (std::uint64_t level = 0; level < this->levelCount; ++level) {
+			const std::uint64_t bit = this->levels[level].firstBit + position(hashed, level, this->levels[level].bits);
+			if (!bitAt(this->words, bit)) {
+				continue;
+			}
+			const std::uint64_t word = bit / 64, block = word / wordsPerRank;
+			std::uint64_t rank = this->ranks[block];
+			for (std::uint64_t i = block * wordsPerRank; i < word; ++i) {
+				rank += std::bitset<64>(this->words[i]).count();
+			}
+			rank += std::bitset<64>(this->words[word] & ((std::uint64_t(1) << (bit % 64)) - 1)).count();
+			return static_cast<std::int64_t>(rank);
+		}
+		return -1;
+	}
+};
+
+template <typename K, typename V, typename Hash>
+void exportSnapshot(hashTable<K, V, Hash> &H, const std::string &path, const Hash &hasher = Hash()) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Build a minimal perfect hash over the keys of H and write it to path, followed by the keys and a packed
+	... value array in index order. Keys and values are written as raw bytes, so both have to be trivially
+	... copyable, and the file is only readable on machines with the same byte order and type sizes.
+	hasher must hash like the one the snapshotView will use. Throws snapshotError if writing fails.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+		"A snapshot stores keys and values as raw bytes.");
+
+	std::vector<K> keys;
+	std::vector<V> values;
+	std::vector<std::uint64_t> hashes;
+	keys.reserve(H.howManyEntries());
+	values.reserve(H.howManyEntries());
+	hashes.reserve(H.howManyEntries());
+	H.forEach([&](const K &key, const V &value) {
+		keys.push_back(key);
+		values.push_back(value);
+		hashes.push_back(static_cast<std::uint64_t>(hasher(key)));
+	});
+	const std::uint64_t entries = keys.size();
+
+	// Build the levels: each round keeps the hashes that had a bit to themselves, and retries the rest.
+	std::vector<snapshotLevel> levels;
+	std::vector<std::uint64_t> words;
+	std::vector<std::uint64_t> remaining(hashes);
+	while (!remaining.empty()) {
+		if (levels.size() == perfectHashIndex::maxLevels) {
+			throw snapshotError("Keys kept colliding on every level, two of them probably share a 64-bit hash.");
+		}
+		const std::uint64_t level = levels.size();
+		const std::uint64_t bits = (remaining.size() * perfectHashIndex::gamma + 63) / 64 * 64;
+		std::vector<std::uint64_t> taken(bits / 64, 0), collided(bits / 64, 0);
+		for (std::uint64_t hashed : remaining) {
+			const std::uint64_t bit = perfectHashIndex::position(hashed, level, bits);
+			if (perfectHashIndex::bitAt(taken.data(), bit)) {
+				collided[bit / 64] |= std::uint64_t(1) << (bit % 64);
+			}
+			taken[bit / 64] |= std::uint64_t(1) << (bit % 64);
+		}
+
+		std::vector<std::uint64_t> next;
+		for (std::uint64_t hashed : remaining) {
+			if (perfectHashIndex::bitAt(collided.data(), perfectHashIndex::position(hashed, level, bits))) {
+				next.push_back(hashed);
+			}
+		}
+		levels.push_back({ words.size() * 64, bits });
+		for (std::uint64_t i = 0; i < bits / 64; ++i) {
+			words.push_back(taken[i] & ~collided[i]);
+		}
+		remaining.swap(next);
+	}
+
+	std::vector<std::uint64_t> ranks(words.size() / perfectHashIndex::wordsPerRank + 1, 0);
+	std::uint64_t setBits = 0;
+	for (std::uint64_t i = 0; i < words.size(); ++i) {
+		if (i % perfectHashIndex::wordsPerRank == 0) {
+			ranks[i / perfectHashIndex::wordsPerRank] = setBits;
+		}
+		setBits += std::bitset<64>(words[i]).count();
+	}
+
+	// Put every entry at its index.
+	const perfectHashIndex index = { levels.data(), levels.size(), words.data(), ranks.data() };
+	std::vector<K> keysByIndex(keys);
+	std::vector<V> valuesByIndex(values);
+	for (std::uint64_t i = 0; i < entries; ++i) {
+		const std::int64_t slot = index.indexOf(hashes[i]);
+		keysByIndex[slot] = keys[i];
+		valuesByIndex[slot] = values[i];
+	}
+
+	auto aligned = [](const std::uint64_t offset) { return (offset + 63) / 64 * 64; };
+	snapshotHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, "PHSNAP1", 8);
+	header.keySize = sizeof(K);
+	header.valueSize = sizeof(V);
+	header.entries = entries;
+	header.levels = levels.size();
+	header.words = words.size();
+	header.levelsOffset = aligned(sizeof(snapshotHeader));
+	header.bitsOffset = aligned(header.levelsOffset + levels.size() * sizeof(snapshotLevel));
+	header.ranksOffset = aligned(header.bitsOffset + words.size() * sizeof(std::uint64_t));
+	header.keysOffset = aligned(header.ranksOffset + ranks.size() * sizeof(std::uint64_t));
+	header.valuesOffset = aligned(header.keysOffset + entries * sizeof(K));
+	header.fileSize = header.valuesOffset + entries * sizeof(V);
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	std::uint64_t written = 0;
+	auto write = [&](const std::uint64_t offset, const void *data, const std::uint64_t bytes) {
+		static const char padding[64] = {};
+		file.write(padding, static_cast<std::streamsize>(offset - written));
+		file.write(static_cast<const char *>(data), static_cast<std::streamsize>(bytes));
+		written = offset + bytes;
+	};
+	write(0, &header, sizeof(header));
+	write(header.levelsOffset, levels.data(), levels.size() * sizeof(snapshotLevel));
+	write(header.bitsOffset, words.data(), words.size() * sizeof(std::uint64_t));
+	write(header.ranksOffset, ranks.data(), ranks.size() * sizeof(std::uint64_t));
+	write(header.keysOffset, keysByIndex.data(), entries * sizeof(K));
+	write(header.valuesOffset, valuesByIndex.data(), entries * sizeof(V));
+	file.close();
+	if (!file) {
+		throw snapshotError("Couldn't write the snapshot file.");
+	}
+}
+
+template <typename K, typename V, typename Hash = hashMixer<K>>
+class snapshotView {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	A read-only table over a file written by exportSnapshot(). Opening only maps the file and checks its
+	... header: nothing is parsed, copied or rebuilt, lookups read the mapped pages directly. Pages are
+	... loaded on first touch and shared by every process that maps the same file.
+
+	A lookup hashes the key, walks the levels until its bit is set (one level for most keys), and compares
+	... the key stored at that index.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+private:
+
+	void *mapping;
+	std::uint64_t bytes;
+	perfectHashIndex index;
+	const K *keys;
+	const V *values;
+	std::uint64_t entries;
+	Hash hasher;
+
+	static bool fits(const std::uint64_t offset, const std::uint64_t count, const std::uint64_t size,
+		const std::uint64_t fileSize) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Whether a section of count items of size bytes, starting at offset, starts on a cache line past the
+		... header and ends inside the file. Written so that no sum or product can overflow.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		return (offset % 64 == 0 && offset >= sizeof(snapshotHeader) && offset <= fileSize &&
+			count <= (fileSize - offset) / size);
+	}
+
+	static bool isValid(const snapshotHeader *header, const std::uint64_t fileSize) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Check everything a lookup will trust before any pointer into the file is made: the magic and type sizes,
+		... that every section is aligned and lies inside the file, and that every level's bits lie inside the
+		... level bits. A truncated or corrupted file fails here instead of reading past the mapping.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (std::memcmp(header->magic, "PHSNAP1", 8) != 0 || header->keySize != sizeof(K) ||
+			header->valueSize != sizeof(V) || header->fileSize != fileSize ||
+			header->levels > perfectHashIndex::maxLevels ||
+			!fits(header->levelsOffset, header->levels, sizeof(snapshotLevel), fileSize) ||
+			!fits(header->bitsOffset, header->words, sizeof(std::uint64_t), fileSize) ||
+			!fits(header->ranksOffset, header->words / perfectHashIndex::wordsPerRank + 1, sizeof(std::uint64_t), fileSize) ||
+			!fits(header->keysOffset, header->entries, sizeof(K), fileSize) ||
+			!fits(header->valuesOffset, header->entries, sizeof(V), fileSize)) {
+			return false;
+		}
+		const snapshotLevel *levels = reinterpret_cast<const snapshotLevel *>(
+			reinterpret_cast<const char *>(header) + header->levelsOffset);
+		for (std::uint64_t level = 0; level < header->levels; ++level) {
+			if (levels[level].firstBit % 64 != 0 || levels[level].bits > header->words * 64 ||
+				levels[level].firstBit > header->words * 64 - levels[level].bits) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+public:
+
+	snapshotView(const std::string &path, const Hash &hashParam = Hash()) : mapping(nullptr), bytes(0), hasher(hashParam) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Map the file at path. Throws snapshotError if it can't be opened, wasn't written for these K and V, or
+		... is truncated or corrupted so that a section would fall outside the file.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+			"A snapshot stores keys and values as raw bytes.");
+
+		const int descriptor = ::open(path.c_str(), O_RDONLY);
+		if (descriptor < 0) {
+			throw snapshotError("Couldn't open the snapshot file.");
+		}
+		struct stat status;
+		if (::fstat(descriptor, &status) != 0 || static_cast<std::uint64_t>(status.st_size) < sizeof(snapshotHeader)) {
+			::close(descriptor);
+			throw snapshotError("The file is too small to be a snapshot.");
+		}
+		this->bytes = static_cast<std::uint64_t>(status.st_size);
+		void *mapped = ::mmap(nullptr, this->bytes, PROT_READ, MAP_SHARED, descriptor, 0);
+		::close(descriptor); // The mapping keeps the file alive.
+		if (mapped == MAP_FAILED) {
+			throw snapshotError("Couldn't map the snapshot file.");
+		}
+		this->mapping = mapped;
+
+		const char *base = static_cast<const char *>(this->mapping);
+		const snapshotHeader *header = reinterpret_cast<const snapshotHeader *>(base);
+		if (!isValid(header, this->bytes)) {
+			::munmap(this->mapping, this->bytes);
+			throw snapshotError("The file isn't a complete snapshot of this key and value type.");
+		}
+		this->index.levels = reinterpret_cast<const snapshotLevel *>(base + header->levelsOffset);
+		this->index.levelCount = header->levels;
+		this->index.words = reinterpret_cast<const std::uint64_t *>(base + header->bitsOffset);
+		this->index.ranks = reinterpret_cast<const std::uint64_t *>(base + header->ranksOffset);
+		this->keys = reinterpret_cast<const K *>(base + header->keysOffset);
+		this->values = reinterpret_cast<const V *>(base + header->valuesOffset);
+		this->entries = header->entries;
+	}
+
+	snapshotView(const snapshotView &) = delete;
+	snapshotView &operator=(const snapshotView &) = delete;
+
+	snapshotView(snapshotView &&other) noexcept : mapping(other.mapping), bytes(other.bytes), index(other.index),
+		keys(other.keys), values(other.values), entries(other.entries), hasher(std::move(other.hasher)) {
+		other.mapping = nullptr;
+	}
+
+	~snapshotView() {
+		if (this->mapping != nullptr) {
+			::munmap(this->mapping, this->bytes);
+		}
+	}
+
+	const V *find(const K &key) const {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		A pointer to the value of key inside the mapping, or nullptr if the key isn't in the snapshot.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const std::int64_t slot = this->index.indexOf(static_cast<std::uint64_t>(this->hasher(key)));
+		if (slot < 0 || static_cast<std::uint64_t>(slot) >= this->entries || !(this->keys[slot] == key)) { // A bad rank can't index past the keys.
+			return nullptr;
+		}
+		return &(this->values[slot]);
+	}
+
+	V at(const K &key) const {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Returns the value of key. If the key doesn't exist, throws keyNotFound.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const V *value = find(key);
+		if (value == nullptr) {
+			throw keyNotFound();
+		}
+		return *value;
+	}
+
+	bool contains(const K &key) const {
+		return (find(key) != nullptr);
+	}
+
+	int howManyEntries() const {
+		return static_cast<int>(this->entries);
+	}
+
+	int levels() const {
+		return static_cast<int>(this->index.levelCount);
+	}
+
+	bool isEmpty() const {
+		return (this->entries == 0);
+	}
+};
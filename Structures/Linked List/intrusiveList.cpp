@@ -0,0 +1,187 @@
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "intrusiveList.h"
+
+long long allocations = 0; // Counted by the replaced operator new below.
+
+void *operator new(std::size_t bytes) {
+	++allocations;
+	void *memory = std::malloc(bytes == 0 ? 1 : bytes);
+	if (memory == nullptr) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void operator delete(void *memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+	std::free(memory);
+}
+
+struct pokemon {
+	std::string name;
+	listHook<pokemon> team;
+	listHook<pokemon> box;
+	forwardListHook<pokemon> party;
+};
+
+std::ostream &operator<<(std::ostream &out, const pokemon &p) {
+	return out << p.name;
+}
+
+struct tracked {
+	int id;
+	listHook<tracked> first;
+	forwardListHook<tracked> second;
+};
+
+template <typename List>
+bool matches(List &L, const std::vector<tracked *> &expected) {
+	if (L.getLength() != static_cast<int>(expected.size())) {
+		return false;
+	}
+	int i = 0;
+	for (tracked &object : L) {
+		if (&object != expected[i++]) {
+			return false;
+		}
+	}
+	return expected.empty() || (&L.top() == expected.front() && &L.back() == expected.back());
+}
+
+bool matchesVectors(const int rounds) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	The same objects on a doubly and a singly linked intrusive list at once, put in and taken out at random
+	... positions, compared against std::vectors of pointers after every call. No call may allocate.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::vector<tracked> objects(64);
+	for (int i = 0; i < 64; ++i) {
+		objects[i].id = i;
+	}
+	intrusiveList<tracked, &tracked::first> First;
+	intrusiveForwardList<tracked, &tracked::second> Second;
+	std::vector<tracked *> onFirst, onSecond;
+	onFirst.reserve(64);
+	onSecond.reserve(64);
+	std::vector<bool> inFirst(64, false), inSecond(64, false);
+	std::mt19937 generator(22);
+
+	const long long before = allocations;
+	for (int i = 0; i < rounds; ++i) {
+		tracked &object = objects[generator() % 64];
+		const bool useFirst = (generator() % 2 == 0);
+		std::vector<tracked *> &expected = useFirst ? onFirst : onSecond;
+		std::vector<bool> &member = useFirst ? inFirst : inSecond;
+		if (!member[object.id]) {
+			const int where = static_cast<int>(generator() % (expected.size() + 1));
+			if (useFirst) {
+				First.insert(where, object);
+			}
+			else {
+				Second.insert(where, object);
+			}
+			expected.insert(expected.begin() + where, &object);
+			member[object.id] = true;
+		}
+		else if (generator() % 2 == 0) {
+			useFirst ? First.remove(object) : Second.remove(object);
+			for (std::size_t k = 0; k < expected.size(); ++k) {
+				if (expected[k] == &object) {
+					expected.erase(expected.begin() + k);
+					break;
+				}
+			}
+			member[object.id] = false;
+		}
+		else {
+			const int where = static_cast<int>(generator() % expected.size());
+			useFirst ? First.deleteNode(where) : Second.deleteNode(where);
+			member[expected[where]->id] = false;
+			expected.erase(expected.begin() + where);
+		}
+		if (!matches(First, onFirst) || !matches(Second, onSecond)) {
+			return false;
+		}
+		if (!expected.empty()) {
+			const int probe = static_cast<int>(generator() % expected.size());
+			if ((useFirst ? &First.at(probe) : &Second.at(probe)) != expected[probe]) {
+				return false;
+			}
+		}
+	}
+	return allocations == before;
+}
+
+int main()
+{
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Gain a few insights on how to use the intrusive lists, and see a testable demo that checks them against std::vector.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::cout << "An intrusive list links objects you already have, through a hook member inside them.\n" << \
+		"Each pokemon here has two listHooks, so it can be on a team and in a box at the same time:\n";
+	std::vector<pokemon> caught(4);
+	const char *names[] = { "Bulbasaur", "Charmander", "Squirtle", "Pikachu" };
+	for (int i = 0; i < 4; ++i) {
+		caught[i].name = names[i];
+	}
+	intrusiveList<pokemon, &pokemon::team> Team;
+	intrusiveList<pokemon, &pokemon::box> Box;
+
+	const long long before = allocations;
+	Team.append(caught[0]);
+	Team.append(caught[1]);
+	Team.insert(1, caught[3]);
+	for (pokemon &each : caught) {
+		Box.append(each);
+	}
+	const long long linkingAllocations = allocations - before;
+	std::cout << "Team: ";
+	Team.print();
+	std::cout << " | Box: ";
+	Box.print();
+
+	std::cout << "\nremove() unlinks an object in O(1), from just the one list: ";
+	Team.remove(caught[3]);
+	Team.print();
+	std::cout << " | Box still: ";
+	Box.print();
+	std::cout << "\nLinking 7 times made " << linkingAllocations << " allocations.\n";
+
+	std::cout << "\nintrusiveForwardList uses a single pointer hook: ";
+	intrusiveForwardList<pokemon, &pokemon::party> Party;
+	Party.append(caught[2]);
+	Party.insert(0, caught[0]);
+	Party.deleteNode(1);
+	Party.append(caught[1]);
+	Party.print();
+	bool tailThrew = false;
+	try {
+		Party.removeAfter(Party.back());
+	}
+	catch (const nullptrProbed &) {
+		tailThrew = true;
+	}
+	std::cout << "\nremoveAfter on the last object throws nullptrProbed: " << tailThrew;
+
+	std::cout << "\n\nRandom links and unlinks on two lists sharing objects, compared against std::vector: ";
+	const bool passed = (linkingAllocations == 0) && tailThrew && Party.getLength() == 2 && matchesVectors(200000);
+	std::cout << (passed ? "passed" : "FAILED") << "\n\n";
+
+	std::cin.get();
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,510 @@
+#pragma once
+
+/// ------------------------------------------------------------------------------------ ///
+/*
+The following .h file includes intrusive linked lists: lists that link objects you already have, through a hook
+member inside the objects, instead of copying each value into a Node of their own.
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <iostream>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+
+#include "../nullptrProbed.h"
+
+template <typename T>
+struct listHook {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Put one of these in T for every intrusiveList an object of T can be on at the same time.
+	Points straight at the neighbouring objects. Both are nullptr while the object is on no list.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	T *next = nullptr;
+	T *previous = nullptr;
+};
+
+template <typename T>
+struct forwardListHook {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	The hook of an intrusiveForwardList: one pointer instead of two, but unlinking an object needs its position.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	T *next = nullptr;
+};
+
+template <typename T, typename Hook, Hook T::*member>
+struct intrusiveIterator {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Forward iterator over the objects of an intrusive list, following the hook given by member.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	typedef std::forward_iterator_tag iterator_category;
+	typedef T value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef T *pointer;
+	typedef T &reference;
+
+	T *object;
+
+	explicit intrusiveIterator(T *objectParam) : object(objectParam) {}
+
+	reference operator*() const {
+		return *(this->object);
+	}
+
+	pointer operator->() const {
+		return this->object;
+	}
+
+	intrusiveIterator &operator++() {
+		this->object = (this->object->*member).next;
+		return *this;
+	}
+
+	intrusiveIterator operator++(int) {
+		intrusiveIterator before = *this;
+		++(*this);
+		return before;
+	}
+
+	bool operator==(const intrusiveIterator &other) const {
+		return this->object == other.object;
+	}
+
+	bool operator!=(const intrusiveIterator &other) const {
+		return this->object != other.object;
+	}
+};
+
+template <typename T, listHook<T> T::*member>
+class intrusiveList {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	A doubly linked list of objects that stay where they are. linkedList copies each value into a Node it
+	... allocates; here the links are the hook member inside T, so linking or unlinking an object never allocates
+	... and never copies it. An object with two hooks can be on two lists at once, e.g.
+		struct pokemon { std::string name; listHook<pokemon> team, box; };
+		intrusiveList<pokemon, &pokemon::team> Team;
+		intrusiveList<pokemon, &pokemon::box> Box;
+
+	append, insert, deleteNode and at work by position like linkedList's. remove(object) unlinks an object in O(1),
+	... since it knows its neighbours. The list never owns its objects: they must outlive their time on the list,
+	... and an object can only be on one list per hook. Destroying or clearing the list unlinks everything.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+private:
+
+	T *head;
+	T *tail;
+	int length;
+
+	static listHook<T> &hook(T &object) {
+		return object.*member;
+	}
+
+	T *objectAt(const int where) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		The object at position where, walking from whichever end is closer.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (where < this->length / 2) {
+			T *current = this->head;
+			for (int i = 0; i < where; ++i) {
+				current = hook(*current).next;
+			}
+			return current;
+		}
+		T *current = this->tail;
+		for (int i = this->length - 1; i > where; --i) {
+			current = hook(*current).previous;
+		}
+		return current;
+	}
+
+public:
+
+	typedef intrusiveIterator<T, listHook<T>, member> iterator;
+
+	intrusiveList() : head(nullptr), tail(nullptr), length(0) {}
+
+	intrusiveList(const intrusiveList &) = delete;
+	intrusiveList &operator=(const intrusiveList &) = delete;
+
+	~intrusiveList() {
+		clear();
+	}
+
+	void append(T &object) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Link object in at the end of the list. It must not be on another list through the same hook.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		hook(object).previous = this->tail;
+		hook(object).next = nullptr;
+		(this->tail == nullptr ? this->head : hook(*(this->tail)).next) = &object;
+		this->tail = &object;
+		++(this->length);
+	}
+
+	void insertBefore(T &position, T &object) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Link object in right before position, an object already on this list. O(1).
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		T *previous = hook(position).previous;
+		hook(object).previous = previous;
+		hook(object).next = &position;
+		hook(position).previous = &object;
+		(previous == nullptr ? this->head : hook(*previous).next) = &object;
+		++(this->length);
+	}
+
+	void insert(const int &where, T &object) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Link object in so that it is at position where (0 = new head, length = append).
+		Exception thrown if we go out of range.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (where < 0 || where > this->length) {
+			throw nullptrProbed(); // Can't access this value of the list, probe led to nullptr
+		}
+		if (where == this->length) {
+			append(object);
+		}
+		else {
+			insertBefore(*objectAt(where), object);
+		}
+	}
+
+	void remove(T &object) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Unlink object, which must be on this list, in O(1). Its hook is reset, so it can go on another list.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		listHook<T> &links = hook(object);
+		(links.previous == nullptr ? this->head : hook(*(links.previous)).next) = links.next;
+		(links.next == nullptr ? this->tail : hook(*(links.next)).previous) = links.previous;
+		links.next = nullptr;
+		links.previous = nullptr;
+		--(this->length);
+	}
+
+	void deleteNode(const int where) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Unlink the object at position where. The object itself is left alone.
+		Exception thrown if we go out of range.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (where < 0 || where >= this->length) {
+			throw nullptrProbed(); // Can't access this value of the list, probe led to nullptr
+		}
+		remove(*objectAt(where));
+	}
+
+	void clear() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Unlink every object, resetting their hooks.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		while (this->head != nullptr) {
+			T *next = hook(*(this->head)).next;
+			hook(*(this->head)) = listHook<T>();
+			this->head = next;
+		}
+		this->tail = nullptr;
+		this->length = 0;
+	}
+
+	T &at(const int i) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Return the object at position i. If i goes outside of the list, exceptions are thrown.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (i < 0 || i >= this->length) {
+			throw nullptrProbed(); // Can't access this value of the list, probe led to nullptr
+		}
+		return *objectAt(i);
+	}
+
+	void print() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Print all objects in the list in a python like list structure. Needs an operator<< for T.
+		Gives "nullptr" string if null.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->head == nullptr) {
+			std::cout << "nullptr\n";
+			return;
+		}
+		std::cout << "<";
+		for (T *current = this->head; current != nullptr; current = hook(*current).next) {
+			std::cout << *current << (current == this->tail ? ">" : ", ");
+		}
+	}
+
+	T &top() {
+		return *(this->head);
+	}
+
+	T &back() {
+		return *(this->tail);
+	}
+
+	int getLength() {
+		return this->length;
+	}
+
+	bool isEmpty() {
+		return (this->length == 0);
+	}
+
+	iterator begin() {
+		return iterator(this->head);
+	}
+
+	iterator end() {
+		return iterator(nullptr);
+	}
+};
+
+template <typename T, forwardListHook<T> T::*member>
+class intrusiveForwardList {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	The singly linked version of intrusiveList, for objects that need to save the second pointer. append, insert,
+	... deleteNode and at are the same, but removing a given object has to find the one before it first, so
+	... remove(object) is O(n) here. removeAfter(object) is O(1).
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+private:
+
+	T *head;
+	T *tail;
+	int length;
+
+	static forwardListHook<T> &hook(T &object) {
+		return object.*member;
+	}
+
+	T *objectBefore(const int where) {
+		T *current = (where == 0) ? nullptr : this->head;
+		for (int i = 1; i < where; ++i) {
+			current = hook(*current).next;
+		}
+		return current;
+	}
+
+	void unlinkAfter(T *previous) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Unlink the object after previous, or the head if previous is nullptr.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		T *&link = (previous == nullptr) ? this->head : hook(*previous).next;
+		T *removed = link;
+		link = hook(*removed).next;
+		if (removed == this->tail) {
+			this->tail = previous;
+		}
+		hook(*removed).next = nullptr;
+		--(this->length);
+	}
+
+public:
+
+	typedef intrusiveIterator<T, forwardListHook<T>, member> iterator;
+
+	intrusiveForwardList() : head(nullptr), tail(nullptr), length(0) {}
+
+	intrusiveForwardList(const intrusiveForwardList &) = delete;
+	intrusiveForwardList &operator=(const intrusiveForwardList &) = delete;
+
+	~intrusiveForwardList() {
+		clear();
+	}
+
+	void append(T &object) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Link object in at the end of the list. It must not be on another list through the same hook.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		hook(object).next = nullptr;
+		(this->tail == nullptr ? this->head : hook(*(this->tail)).next) = &object;
+		this->tail = &object;
+		++(this->length);
+	}
+
+	void insert(const int &where, T &object) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Link object in so that it is at position where (0 = new head, length = append).
+		Exception thrown if we go out of range.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (where < 0 || where > this->length) {
+			throw nullptrProbed(); // Can't access this value of the list, probe led to nullptr
+		}
+		if (where == this->length) {
+			append(object);
+			return;
+		}
+		T *previous = objectBefore(where);
+		T *&link = (previous == nullptr) ? this->head : hook(*previous).next;
+		hook(object).next = link;
+		link = &object;
+		++(this->length);
+	}
+
+	void removeAfter(T &previous) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Unlink the object after previous, in O(1). previous must be on this list.
+		Exception thrown if previous is the last object, there's nothing after it to remove.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (hook(previous).next == nullptr) {
+			throw nullptrProbed(); // Can't access this value of the list, probe led to nullptr
+		}
+		unlinkAfter(&previous);
+	}
+
+	void remove(T &object) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Unlink object, which must be on this list. Walks to the object before it, so O(n).
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		T *previous = nullptr;
+		for (T *current = this->head; current != &object; current = hook(*current).next) {
+			previous = current;
+		}
+		unlinkAfter(previous);
+	}
+
+	void deleteNode(const int where) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Unlink the object at position where. The object itself is left alone.
+		Exception thrown if we go out of range.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (where < 0 || where >= this->length) {
+			throw nullptrProbed(); // Can't access this value of the list, probe led to nullptr
+		}
+		unlinkAfter(objectBefore(where));
+	}
+
+	void clear() {
+		while (this->head != nullptr) {
+			T *next = hook(*(this->head)).next;
+			hook(*(this->head)).next = nullptr;
+			this->head = next;
+		}
+		this->tail = nullptr;
+		this->length = 0;
+	}
+
+	T &at(const int i) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Return the object at position i. If i goes outside of the list, exceptions are thrown.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (i < 0 || i >= this->length) {
+			throw nullptrProbed(); // Can't access this value of the list, probe led to nullptr
+		}
+		return (i == 0) ? *(this->head) : *(hook(*objectBefore(i)).next);
+	}
+
+	void print() {
+		if (this->head == nullptr) {
+			std::cout << "nullptr\n";
+			return;
+		}
+		std::cout << "<";
+		for (T *current = this->head; current != nullptr; current = hook(*current).next) {
+			std::cout << *current << (current == this->tail ? ">" : ", ");
+		}
+	}
+
+	T &top() {
+		return *(this->head);
+	}
+
+	T &back() {
+		return *(this->tail);
+	}
+
+	int getLength() {
+		return this->length;
+	}
+
+	bool isEmpty() {
+		return (this->length == 0);
+	}
+
+	iterator begin() {
+		return iterator(this->head);
+	}
+
+	iterator end() {
+		return iterator(nullptr);
+	}
+};
@@ -1,5 +1,64 @@
+#include <algorithm>
+#include <chrono>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <vector>
 #include "linkedList.h"
 
+bool matchesVector(const listIndex indexing, const int rounds) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Random appends, inserts and deletes on a linkedList<int> and a std::vector, compared after every call.
+	Deleted nodes are reused by later inserts, so this also checks the pool's free list.
+	With listIndex::skipList every positional call goes through the skip index instead.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	linkedList<int> L(indexing);
+	std::vector<int> expected;
+	std::mt19937 generator(17);
+	for (int i = 0; i < rounds; ++i) {
+		const int choice = static_cast<int>(generator() % 4);
+		if (choice == 0 || expected.empty()) {
+			L.append(i);
+			expected.push_back(i);
+		}
+		else if (choice == 1) {
+			const int where = static_cast<int>(generator() % (expected.size() + 1));
+			L.insert(where, i);
+			expected.insert(expected.begin() + where, i);
+		}
+		else {
+			const int where = static_cast<int>(generator() % expected.size());
+			L.deleteNode(where);
+			expected.erase(expected.begin() + where);
+		}
+		if (L.getLength() != static_cast<int>(expected.size()) || L.isEmpty() != expected.empty()) {
+			return false;
+		}
+		if (!expected.empty()) {
+			const int probe = static_cast<int>(generator() % expected.size());
+			if (L.at(probe) != expected[probe] || L.top() != expected.front() || L.back() != expected.back()) {
+				return false;
+			}
+			if (L.find(expected[probe]) != probe || L.count(expected[probe]) != 1 || L.find(-1) != -1) {
+				return false;
+			}
+		}
+	}
+	const linkedList<int> copy(L);
+	linkedList<int> assigned;
+	assigned = copy;
+	for (int i = 0; i < static_cast<int>(expected.size()); ++i) {
+		if (assigned.at(i) != expected[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
 int main()
 {
 
@@ -11,7 +70,7 @@ int main()
 
 	std::cout << "Here, we will showcase the usage of the likedList class.\nYou declare a linkedList like so: linkedList<data_type> variable_name.\n";
 	linkedList<int> List;
-	std::cout << "\nYou should use initList on each list object you create. \nThis allows us to avoid exceptions, and ensure at least one node exists.\n";
+	std::cout << "\ninitList starts (or restarts) a list with a single value. \nAppending to an empty list works too.\n";
 	List.initList(4);
 	List.append(5);
 	List.append(6);
@@ -31,7 +90,89 @@ int main()
 	List2 = List;
 	std::cout << "\n\nAssignment of list to another, the second list has turned into the original: ";
 	List.print();
-	std::cout << "\n\n";
+
+	std::cout << "\n\nNodes come from slabs owned by the list. Give lists a std::pmr allocator and they share one arena instead:\n";
+	std::pmr::monotonic_buffer_resource arena;
+	linkedList<int, std::pmr::polymorphic_allocator<int>> First(&arena), Second(&arena);
+	for (int i = 0; i < 5; ++i) {
+		First.append(i);
+		Second.append(i * i);
+	}
+	First.print();
+	std::cout << " ";
+	Second.print();
+
+	std::cout << "\n\nLists have forward iterators, so range-for and the standard algorithms work: ";
+	int sum = 0;
+	for (int value : First) {
+		sum += value;
+	}
+	std::cout << "sum " << sum << ", 9 found: " << (std::find(Second.begin(), Second.end(), 9) != Second.end());
+	std::cout << "\nfind, find_if and count are members too. 16 is at index " << Second.find(16) << \
+		", the first value over 5 is at index " << Second.find_if([](int value) { return value > 5; }) << \
+		", and 3 appears " << Second.count(3) << " time(s).";
+	std::cout << "\nconcat relinks the second list's nodes onto the first without copying, and leaves it empty: ";
+	First.concat(Second);
+	First.print();
+	std::cout << " ";
+	Second.print();
+	std::cout << "emplace_after builds a value in place after an iterator: ";
+	linkedList<std::string> Words;
+	Words.emplace_back("hello");
+	Words.emplace_after(Words.begin(), 3, '!');
+	Words.print();
+
+	std::cout << "\n\nsort, unique, reverse and merge relink the nodes instead of moving values around:\n";
+	linkedList<std::string> Team;
+	const char *names[] = { "Squirtle", "Pikachu", "Bulbasaur", "Pikachu", "Charmander", "Bulbasaur" };
+	for (const char *name : names) {
+		Team.append(name);
+	}
+	Team.sort();
+	Team.print();
+	std::cout << " -> unique removed " << Team.unique() << ": ";
+	Team.print();
+	linkedList<std::string> More;
+	More.append("Eevee");
+	More.append("Snorlax");
+	Team.merge(More);
+	std::cout << "\nmerged with <Eevee, Snorlax> and reversed: ";
+	Team.reverse();
+	Team.print();
+
+	std::cout << "\n\nclear() hands all of a list's memory back at once. 10,000,000 ints cleared in ";
+	linkedList<int> Large;
+	for (int i = 0; i < 10000000; ++i) {
+		Large.append(i);
+	}
+	const auto start = std::chrono::steady_clock::now();
+	Large.clear();
+	std::cout << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms";
+	std::cout << "\nA list of 10,000,000 strings is destroyed in a loop, not through nested destructors: ";
+	{
+		linkedList<std::string> Strings;
+		for (int i = 0; i < 10000000; ++i) {
+			Strings.append(std::to_string(i));
+		}
+	}
+	std::cout << "done.";
+
+	std::cout << "\n\nWith listIndex::skipList, at, insert and deleteNode find their position in O(log n) steps:\n";
+	linkedList<int> Indexed(listIndex::skipList);
+	for (int i = 0; i < 1000000; ++i) {
+		Indexed.append(i);
+	}
+	Indexed.insert(500000, -1);
+	Indexed.deleteNode(250000);
+	std::cout << "at(499999) after inserting -1 at 500000 and deleting at 250000: " << Indexed.at(499999) << "\n";
+
+	std::cout << "\nRandom appends, inserts and deletes compared against std::vector: ";
+	const bool plainPassed = matchesVector(listIndex::none, 100000);
+	std::cout << (plainPassed ? "passed" : "FAILED") << "\n";
+	std::cout << "The same, through the skip index: ";
+	const bool indexedPassed = matchesVector(listIndex::skipList, 100000);
+	std::cout << (indexedPassed ? "passed" : "FAILED") << "\n\n";
+	const bool passed = plainPassed && indexedPassed;
 	std::cin.get();
-	return 0;
+	return passed ? 0 : 1;
 }
@@ -8,77 +8,796 @@ Node<T> values with pointers and a data type.
 /// ------------------------------------------------------------------------------------ ///
 
 #include <iostream>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <functional>
+#include <iterator>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
-struct nullptrProbed : public std::exception {
+// sort() always runs on the calling thread unless LINKED_LIST_THREADS is defined as 1 (before including, or with
+// ... -DLINKED_LIST_THREADS=1). Then long lists are split across threads, so build with threads enabled, e.g. -pthread.
+#ifndef LINKED_LIST_THREADS
+#define LINKED_LIST_THREADS 0
+#endif
+
+#if LINKED_LIST_THREADS
+#include <atomic>
+#include <thread>
+#endif
+
+#include "../nullptrProbed.h"
+
+template <typename T>
+struct Node {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Node<T> class, has a pointer to the next Node and a data value of type T.
+	Not meant to be used or accessed outside of the list structure.
+	The pointer doesn't own anything: every Node lives in its list's nodePool.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	T data;
+	Node<T> *next;
+
+	template <typename... Args>
+	explicit Node(Args&&... args) : data(std::forward<Args>(args)...), next(nullptr) {}
+};
+
+template <typename T, typename Allocator = std::allocator<T>>
+class nodePool {
 
 	/// ------------------------------------------------------------------------------------ ///
 	/*
-	Custom exception. users do not want their program to continue when accessing a nullptr.
+	Where a list gets its Nodes from. Memory is taken from Allocator in slabs of many nodes (32, then doubling up to
+	... 65536), and a node is handed out by bumping an index into the newest slab. A released node goes on a free
+	... list threaded through its own memory, and is the next one handed out. So after warming up, acquiring and
+	... releasing a node are a couple of pointer moves, and nodes sit next to each other in the order they were made.
+
+	Allocator is any standard allocator of T; it is rebound to Node<T>. Passing a std::pmr::polymorphic_allocator
+	... lets many lists take their slabs from one memory_resource, e.g. a monotonic arena.
+	Slabs are only handed back to Allocator all at once, by reset() or when the pool is destroyed.
 	*/
 	/// ------------------------------------------------------------------------------------ ///
 
-	const char * what() const throw() {
-		return "Can't access this value of the list, probe led to nullptr.";
+private:
+
+	typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node<T>> nodeAllocator;
+	typedef std::allocator_traits<nodeAllocator> nodeTraits;
+
+	struct slab {
+		Node<T> *nodes;
+		std::size_t count;
+	};
+
+	struct freeSlot {
+		freeSlot *next;
+	};
+
+	enum : std::size_t { firstSlab = 32, largestSlab = 65536 };
+
+	nodeAllocator allocator;
+	std::vector<slab, typename std::allocator_traits<Allocator>::template rebind_alloc<slab>> slabs;
+	freeSlot *freeList;
+	std::size_t used; // Nodes handed out from the newest slab.
+
+	Node<T> *rawNode() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Memory for one node, not constructed yet. From the free list first, then from the newest slab.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->freeList != nullptr) {
+			freeSlot *slot = this->freeList;
+			this->freeList = slot->next;
+			return reinterpret_cast<Node<T> *>(slot);
+		}
+		if (this->slabs.empty() || this->used == this->slabs.back().count) {
+			const std::size_t count = this->slabs.empty() ? std::size_t(firstSlab) :
+				std::min<std::size_t>(this->slabs.back().count * 2, largestSlab);
+			this->slabs.reserve(this->slabs.size() + 1);
+			this->slabs.push_back(slab{ nodeTraits::allocate(this->allocator, count), count });
+			this->used = 0;
+		}
+		return this->slabs.back().nodes + (this->used)++;
+	}
+
+	void recycle(Node<T> *node) {
+		this->freeList = ::new (static_cast<void *>(node)) freeSlot{ this->freeList };
+	}
+
+public:
+
+	explicit nodePool(const Allocator &allocatorParam = Allocator()) :
+		allocator(allocatorParam), slabs(allocatorParam), freeList(nullptr), used(0) {}
+
+	nodePool(const nodePool &) = delete;
+	nodePool &operator=(const nodePool &) = delete;
+
+	~nodePool() {
+		reset();
+	}
+
+	void reset() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Give every slab back, without looking at the nodes in them. The list has already destroyed the nodes
+		... still in use, if they needed it. One deallocation per slab, so about log2(n) + n / 65536 in total.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		for (const slab &each : this->slabs) {
+			nodeTraits::deallocate(this->allocator, each.nodes, each.count);
+		}
+		this->slabs.clear();
+		this->freeList = nullptr;
+		this->used = 0;
+	}
+
+	template <typename... Args>
+	Node<T> *acquire(Args&&... args) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		A new node constructed from args, with next set to nullptr. If constructing T throws, the memory is kept.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		Node<T> *node = rawNode();
+		try {
+			construct(node, std::forward<Args>(args)...);
+		}
+		catch (...) {
+			recycle(node);
+			throw;
+		}
+		return node;
+	}
+
+	void release(Node<T> *node) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Destroy a node from acquire and keep its memory for the next one.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		nodeTraits::destroy(this->allocator, node);
+		recycle(node);
+	}
+
+	void destroy(Node<T> *node) {
+		nodeTraits::destroy(this->allocator, node);
+	}
+
+	Node<T> *acquireBlock(const std::size_t count) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Memory for count nodes side by side, from one allocation, not constructed yet. Construct them with
+		... construct(). The block gets a slab of its own, and the newest slab stays the one nodes are bumped from.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		this->slabs.reserve(this->slabs.size() + 1);
+		const slab block{ nodeTraits::allocate(this->allocator, count), count };
+		if (this->slabs.empty()) {
+			this->slabs.push_back(block);
+			this->used = count;
+		}
+		else {
+			this->slabs.insert(this->slabs.end() - 1, block);
+		}
+		return block.nodes;
+	}
+
+	template <typename... Args>
+	void construct(Node<T> *node, Args&&... args) {
+		nodeTraits::construct(this->allocator, node, std::forward<Args>(args)...);
+	}
+
+	bool shares(const nodePool &other) const {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		True if either pool can free the other's memory, so nodes can move between them.
+		Always for std::allocator, and for pmr allocators on the same memory_resource.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		return this->allocator == other.allocator;
+	}
+
+	void adopt(nodePool &other) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Take over all of other's slabs, and with them every node other handed out. Only if shares(other).
+		O(number of slabs), which is O(log n). When this pool already has slabs, other's free slots and the rest
+		... of its newest slab aren't reused, just freed with the rest.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->slabs.empty()) {
+			this->slabs.swap(other.slabs);
+			std::swap(this->freeList, other.freeList);
+			std::swap(this->used, other.used);
+		}
+		else {
+			this->slabs.insert(this->slabs.begin(), other.slabs.begin(), other.slabs.end());
+			other.slabs.clear();
+			other.freeList = nullptr;
+			other.used = 0;
+		}
+	}
+
+	Allocator get_allocator() const {
+		return Allocator(this->allocator);
 	}
 };
 
-template <typename T>
-struct Node {
+enum class listIndex { none, skipList };
+
+template <typename T, typename Allocator = std::allocator<T>>
+class skipIndex {
 
 	/// ------------------------------------------------------------------------------------ ///
 	/*
-	Node<T> class, has a pointer to the next Node and a data value of type T.
-	Not meant to be used or accessed outside of the list structure.
+	The express lanes of an indexable skip list, laid over the Nodes of a linkedList without changing them.
+	About one node in 4 gets a tower of links, one in 16 a tower at least 2 high, and so on. The link at level l
+	... jumps to the next tower that reaches level l, and records its width: how many nodes the jump skips over.
+	Finding position i goes down from the top level, taking every jump that doesn't pass i, then walks the last
+	... few nodes of the list itself (about 4). That's O(log n) expected for a walk that used to take i steps.
+
+	Inserting or deleting at a position only touches the last tower before it on each level, so it's O(log n) too.
+	seek() leaves that path behind, and linked()/unlinked() use it, so the list calls seek(where - 1) first.
+	The head tower stands before the first node, at position -1. The width of a link to nullptr is not used.
 	*/
 	/// ------------------------------------------------------------------------------------ ///
 
-	T data;
-	std::shared_ptr<Node<T>> next;
+private:
+
+	struct skipLink {
+		skipLink *next; // Level 0 of the next tower that reaches this level.
+		Node<T> *node;  // Set on level 0 of each tower.
+		int width;
+		int height;     // Set on level 0 of each tower.
+	};
+
+	typedef typename std::allocator_traits<Allocator>::template rebind_alloc<skipLink> linkAllocator;
+	typedef std::allocator_traits<linkAllocator> linkTraits;
+
+	enum : int { maxLevels = 16 };
+
+	linkAllocator allocator;
+	skipLink *head;
+	int levels;
+	std::uint32_t seed;
+	skipLink *path[maxLevels];
+	int pathPosition[maxLevels];
+
+	skipLink *newTower(Node<T> *node, const int height) {
+		skipLink *tower = linkTraits::allocate(this->allocator, height);
+		for (int level = 0; level < height; ++level) {
+			tower[level] = skipLink{ nullptr, node, 1, height };
+		}
+		return tower;
+	}
+
+	int randomHeight() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		0 with probability 3/4, then each further level with probability 1/4. xorshift32 for the random bits.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		this->seed ^= this->seed << 13;
+		this->seed ^= this->seed >> 17;
+		this->seed ^= this->seed << 5;
+		std::uint32_t bits = this->seed;
+		int height = 0;
+		while ((bits & 3) == 0 && height < maxLevels) {
+			++height;
+			bits >>= 2;
+		}
+		return height;
+	}
+
+public:
+
+	explicit skipIndex(const Allocator &allocatorParam = Allocator()) :
+		allocator(allocatorParam), head(nullptr), levels(0), seed(2463534242u) {}
+
+	skipIndex(const skipIndex &) = delete;
+	skipIndex &operator=(const skipIndex &) = delete;
+
+	~skipIndex() {
+		reset();
+	}
+
+	Node<T> *seek(const int target, Node<T> *first) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Returns the node at position target of the list starting at first, or nullptr for target -1.
+		Remembers the last tower at or before target on every level, for linked() and unlinked().
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->head == nullptr) {
+			this->head = newTower(nullptr, maxLevels);
+		}
+		skipLink *tower = this->head;
+		int position = -1;
+		for (int level = this->levels - 1; level >= 0; --level) {
+			while (tower[level].next != nullptr && position + tower[level].width <= target) {
+				position += tower[level].width;
+				tower = tower[level].next;
+			}
+			this->path[level] = tower;
+			this->pathPosition[level] = position;
+		}
+
+		if (target == -1) {
+			return nullptr;
+		}
+		Node<T> *node = (position == -1) ? first : tower->node;
+		for (int steps = (position == -1) ? target : target - position; steps > 0; --steps) {
+			node = node->next;
+		}
+		return node;
+	}
+
+	void linked(const int where, Node<T> *node) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		node was just linked in at position where, after seek(where - 1). Maybe give it a tower, and lengthen
+		... the jumps that now pass over one more node.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const int height = randomHeight();
+		skipLink *tower = (height > 0) ? newTower(node, height) : nullptr;
+		for (; this->levels < height; ++(this->levels)) {
+			this->path[this->levels] = this->head;
+			this->pathPosition[this->levels] = -1;
+			this->head[this->levels].next = nullptr;
+		}
+		for (int level = 0; level < this->levels; ++level) {
+			skipLink *before = this->path[level];
+			if (level < height) {
+				tower[level].next = before[level].next;
+				tower[level].width = this->pathPosition[level] + before[level].width + 1 - where;
+				before[level].next = tower;
+				before[level].width = where - this->pathPosition[level];
+			}
+			else {
+				++(before[level].width);
+			}
+		}
+	}
+
+	void unlinked(Node<T> *node) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		node was just unlinked, after seek(where - 1) for its position where. Jumps over it get shorter, and jumps
+		... to its tower are rerouted past it before the tower is freed.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		skipLink *removed = nullptr;
+		for (int level = 0; level < this->levels; ++level) {
+			skipLink *before = this->path[level];
+			skipLink *next = before[level].next;
+			if (next != nullptr && next->node == node) {
+				before[level].width += next[level].width - 1;
+				before[level].next = next[level].next;
+				removed = next;
+			}
+			else {
+				--(before[level].width);
+			}
+		}
+		if (removed != nullptr) {
+			linkTraits::deallocate(this->allocator, removed, removed->height);
+		}
+		while (this->levels > 0 && this->head[this->levels - 1].next == nullptr) {
+			--(this->levels);
+		}
+	}
+
+	void swap(skipIndex &other) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Trade towers with other, for when two lists trade all of their nodes. The allocators must share memory.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		std::swap(this->head, other.head);
+		std::swap(this->levels, other.levels);
+	}
+
+	void rebuild(Node<T> *first) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Throw the towers away and build new ones over the whole list starting at first, in one pass.
+		O(n), for when many nodes arrive at once, instead of n calls to linked().
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		reset();
+		this->head = newTower(nullptr, maxLevels);
+		for (int level = 0; level < maxLevels; ++level) {
+			this->path[level] = this->head;
+			this->pathPosition[level] = -1;
+		}
+		int position = 0;
+		for (Node<T> *node = first; node != nullptr; node = node->next, ++position) {
+			const int height = randomHeight();
+			if (height == 0) {
+				continue;
+			}
+			skipLink *tower = newTower(node, height);
+			for (int level = 0; level < height; ++level) {
+				this->path[level][level].next = tower;
+				this->path[level][level].width = position - this->pathPosition[level];
+				this->path[level] = tower;
+				this->pathPosition[level] = position;
+			}
+			this->levels = std::max(this->levels, height);
+		}
+	}
 
+	void reset() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Free every tower. Level 0 links them all in order.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->head == nullptr) {
+			return;
+		}
+		skipLink *tower = (this->levels > 0) ? this->head[0].next : nullptr;
+		while (tower != nullptr) {
+			skipLink *next = tower[0].next;
+			linkTraits::deallocate(this->allocator, tower, tower->height);
+			tower = next;
+		}
+		linkTraits::deallocate(this->allocator, this->head, maxLevels);
+		this->head = nullptr;
+		this->levels = 0;
+	}
 };
 
-template <typename T>
+template <typename T, typename Value = T>
+struct linkedListIterator {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Forward iterator over the values of a linkedList. Value is const T for the const_iterator.
+	It also counts its position, which emplace_after and splice_after use on a list with a skip index.
+	Deleting a node invalidates iterators to it. On a list with a skip index, any insert or delete before an
+	... iterator invalidates it too, since its position has changed.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	typedef std::forward_iterator_tag iterator_category;
+	typedef T value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef Value *pointer;
+	typedef Value &reference;
+
+	Node<T> *node;
+	int position;
+
+	linkedListIterator(Node<T> *nodeParam, const int positionParam) : node(nodeParam), position(positionParam) {}
+
+	linkedListIterator(const linkedListIterator<T, T> &other) : node(other.node), position(other.position) {}
+
+	reference operator*() const {
+		return this->node->data;
+	}
+
+	pointer operator->() const {
+		return &(this->node->data);
+	}
+
+	linkedListIterator &operator++() {
+		this->node = this->node->next;
+		++(this->position);
+		return *this;
+	}
+
+	linkedListIterator operator++(int) {
+		linkedListIterator before = *this;
+		++(*this);
+		return before;
+	}
+
+	bool operator==(const linkedListIterator &other) const {
+		return this->node == other.node;
+	}
+
+	bool operator!=(const linkedListIterator &other) const {
+		return this->node != other.node;
+	}
+};
+
+template <typename T, typename Allocator = std::allocator<T>>
 class linkedList {
 
-	/// ------------------------------------------------------------------------------------ ///
-	/*
-	You should initialize the list using the initialization function.
-	Template implementation of the linked list like data structure.
-	Linked lists can be used to implement arrays, vectors, etc. This template based linked list uses a collection
-	of Nodes with values data of type T, and pointers to each next Node.
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Template implementation of the linked list like data structure.
+	Linked lists can be used to implement arrays, vectors, etc. This template based linked list uses a collection
+	of Nodes with values data of type T, and pointers to each next Node.
+
+	The list contains a head and a tail so we can access those elements in O(1) time.
+	Nodes come from a nodePool owned by the list, so appending doesn't call the allocator for every value, and
+	... walking the list is plain pointer chasing, with no reference counts to update on each step.
+
+	Iterate it with begin() and end() (or a range-for) rather than at(i) in a loop.
+	concat and splice_after move another list's nodes into this one by relinking them, without copying values.
+	sort, merge, unique and reverse relink nodes as well, so they never copy or move a T either.
+
+	at, insert and deleteNode walk from the head to the position they're given, so n of them cost O(n^2).
+	Construct the list with listIndex::skipList and it keeps a skipIndex beside the nodes, which finds any
+	... position in O(log n) instead. Appending also goes through the index then, so it becomes O(log n) too.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+private:
+
+	nodePool<T, Allocator> pool;
+	skipIndex<T, Allocator> index;
+	listIndex indexing;
+	Node<T> *head;
+	Node<T> *tail;
+	int length;
+
+	Node<T> *nodeBefore(const int where) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		The node at position where - 1, through the index if there is one. nullptr if where is 0.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->indexing == listIndex::skipList) {
+			return this->index.seek(where - 1, this->head);
+		}
+		if (where == 0) {
+			return nullptr;
+		}
+		Node<T> *current = this->head;
+		for (int i = 1; i < where; ++i) {
+			current = current->next;
+		}
+		return current;
+	}
+
+	void relink(Node<T> *before, linkedList &other) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Link all of other's nodes in after before (at the front if before is nullptr), and take over the slabs
+		... they live in, leaving other empty. Needs pool.shares(other.pool). No value is copied or moved.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const bool tradeIndex = (this->head == nullptr && this->indexing == other.indexing);
+		Node<T> *&after = (before == nullptr) ? this->head : before->next;
+		other.tail->next = after;
+		if (after == nullptr) {
+			this->tail = other.tail;
+		}
+		after = other.head;
+		this->length += other.length;
+		this->pool.adopt(other.pool);
+		if (tradeIndex) {
+			this->index.swap(other.index); // This list was empty, so other's towers are already right.
+		}
+		other.index.reset();
+		other.head = nullptr;
+		other.tail = nullptr;
+		other.length = 0;
+		if (this->indexing == listIndex::skipList && !tradeIndex) {
+			this->index.rebuild(this->head);
+		}
+	}
+
+	template <typename Compare>
+	static Node<T> *mergeChains(Node<T> *first, Node<T> *second, Compare &less, bool &firstLast) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Merge two sorted chains of nodes (ending in nullptr) into one by relinking, and return its first node.
+		Stable: of two equal values, the one from first comes first. firstLast says whose node ends the result.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		Node<T> *result = nullptr;
+		Node<T> **link = &result;
+		while (first != nullptr && second != nullptr) {
+			if (less(second->data, first->data)) {
+				*link = second;
+				second = second->next;
+			}
+			else {
+				*link = first;
+				first = first->next;
+			}
+			link = &((*link)->next);
+		}
+		firstLast = (first != nullptr);
+		*link = firstLast ? first : second;
+		return result;
+	}
+
+	template <typename Compare>
+	static Node<T> *sortChain(Node<T> *chain, Compare &less) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Bottom-up merge sort of a chain of nodes. Bin i holds a sorted run of 2^i nodes (or nothing). Each node
+		... taken off the chain is merged with bins 0, 1, 2... as long as they are full, like carrying in binary
+		... addition, then the bins are merged together. No recursion, and 64 pointers of extra space.
+		Bins always hold older nodes than the run merged into them, so they go first and the sort is stable.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		Node<T> *bins[64] = {};
+		bool firstLast;
+		while (chain != nullptr) {
+			Node<T> *carry = chain;
+			chain = chain->next;
+			carry->next = nullptr;
+			int bin = 0;
+			for (; bins[bin] != nullptr; ++bin) {
+				carry = mergeChains(bins[bin], carry, less, firstLast);
+				bins[bin] = nullptr;
+			}
+			bins[bin] = carry;
+		}
+		Node<T> *result = nullptr;
+		for (Node<T> *run : bins) {
+			if (run != nullptr) {
+				result = mergeChains(run, result, less, firstLast);
+			}
+		}
+		return result;
+	}
+
+#if LINKED_LIST_THREADS
+	template <typename Work>
+	static void runTasks(const int tasks, const int threads, Work work) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Run work(0) ... work(tasks - 1) on a small pool of threads, the calling thread being one of them.
+		Each worker takes the next task number off a shared counter until there are none left.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		std::atomic<int> next(0);
+		auto worker = [&]() {
+			for (int task = next++; task < tasks; task = next++) {
+				work(task);
+			}
+		};
+		std::vector<std::thread> workers;
+		for (int t = 1; t < std::min(threads, tasks); ++t) {
+			workers.emplace_back(worker);
+		}
+		worker();
+		for (std::thread &each : workers) {
+			each.join();
+		}
+	}
+
+	template <typename Compare>
+	Node<T> *parallelSort(const int parts, const int threads, Compare &less) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Cut the list into parts chains of about equal length, sort each on its own thread, then merge neighbours
+		... in rounds, every merge of a round on its own thread, until one chain is left. Cutting and merging
+		... only relink nodes. Neighbours merge earlier part first, so this is as stable as sortChain.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		std::vector<Node<T> *> pieces(parts);
+		Node<T> *current = this->head;
+		for (int part = 0; part < parts; ++part) {
+			pieces[part] = current;
+			const int size = this->length / parts + (part < this->length % parts ? 1 : 0);
+			for (int i = 1; i < size; ++i) {
+				current = current->next;
+			}
+			Node<T> *next = current->next;
+			current->next = nullptr;
+			current = next;
+		}
+
+		runTasks(parts, threads, [&](const int part) {
+			pieces[part] = sortChain(pieces[part], less);
+		});
+		for (int width = 1; width < parts; width *= 2) {
+			runTasks((parts + 2 * width - 1) / (2 * width), threads, [&](const int merge) {
+				const int first = merge * 2 * width, second = first + width;
+				if (second < parts) {
+					bool firstLast;
+					pieces[first] = mergeChains(pieces[first], pieces[second], less, firstLast);
+				}
+			});
+		}
+		return pieces[0];
+	}
+#endif
 
-	The list contains a head and a tail so we can access those elements in O(1) time.
-	*/
-	/// ------------------------------------------------------------------------------------ ///
+	void relinked() {
 
-private:
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		After the nodes were put in a new order: find the new tail and rebuild the skip index, if there is one.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
 
-	std::shared_ptr<Node<T>> head;
-	std::shared_ptr<Node<T>> tail;
-	int length;
+		this->tail = this->head;
+		while (this->tail != nullptr && this->tail->next != nullptr) {
+			this->tail = this->tail->next;
+		}
+		if (this->indexing == listIndex::skipList) {
+			this->index.rebuild(this->head);
+		}
+	}
 
 public:
 
-	linkedList<T> operator=(linkedList<T> &other) {
+	enum : int { parallelSortPart = 1 << 16 }; // Fewest nodes per thread worth sorting in parallel.
+
+	typedef linkedListIterator<T, T> iterator;
+	typedef linkedListIterator<T, const T> const_iterator;
+
+	linkedList &operator=(const linkedList &other) {
 
 		/// ------------------------------------------------------------------------------------ ///
 		/*
-		Assign one linked list's values into a new list. Creates a deep copy.
+		Assign one linked list's values into this list. Creates a deep copy. The list keeps its own allocator.
 		*/
 		/// ------------------------------------------------------------------------------------ ///
 
-		copyList(other);
+		if (this != &other) {
+			copyList(other);
+		}
 		return *this;
-
 	}
 
-	linkedList() {
+	explicit linkedList(const listIndex indexParam = listIndex::none, const Allocator &allocatorParam = Allocator()) :
+		pool(allocatorParam), index(allocatorParam), indexing(indexParam) {
 
 		/// ------------------------------------------------------------------------------------ ///
 		/*
 		Basic constructor of the linked list data structure. Assigns head and tail to nullptr.
+		Pass listIndex::skipList for O(log n) positional access, and an allocator to take the nodes from somewhere
+		... other than the heap, e.g. a std::pmr arena.
 		*/
 		/// ------------------------------------------------------------------------------------ ///
 
@@ -87,32 +806,90 @@ public:
 		this->length = 0;
 	}
 
+	explicit linkedList(const Allocator &allocatorParam) : linkedList(listIndex::none, allocatorParam) {}
+
+	linkedList(linkedList &&other) : linkedList(other.indexing, other.get_allocator()) {
+		concat(other);
+	}
+
+	linkedList &operator=(linkedList &&other) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Take other's values. Its nodes are relinked into this list when both allocators share memory,
+		... and moved one by one otherwise. other is left empty.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this != &other) {
+			clear();
+			concat(other);
+		}
+		return *this;
+	}
+
+	linkedList(const linkedList &other) : linkedList(other.indexing,
+		std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())) {
+		copyList(other);
+	}
+
+	~linkedList() {
+		clear();
+	}
+
 	void initList(T value) {
 
 		/// ------------------------------------------------------------------------------------ ///
 		/*
 		Initialize a list so we can access the values without reaching nullptr.
+		Any values already in the list are dropped.
 		*/
 		/// ------------------------------------------------------------------------------------ ///
 
-		this->head = std::make_shared<Node<T>>();
-		this->head->next = nullptr;
-		this->head->data = value;
-		this->tail = this->head;
-		this->length = 1;
+		destructList();
+		append(value);
 	}
 
 	void destructList() {
 
 		/// ------------------------------------------------------------------------------------ ///
 		/*
-		Free all of the memory used inside of the list.
+		Empty the list. The nodes go back to the pool one at a time, and the pool keeps their memory for the next
+		... values. Use clear() to give the memory back instead.
 		*/
 		/// ------------------------------------------------------------------------------------ ///
 
 		while (this->head != nullptr) {
-			this->head = this->head->next;
+			Node<T> *next = this->head->next;
+			this->pool.release(this->head);
+			this->head = next;
+		}
+		this->index.reset();
+		this->tail = nullptr;
+		this->length = 0;
+	}
+
+	void clear() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Remove every value and hand all of the list's memory back at once. Unlike destructList, the nodes are not
+		... walked one by one when T has nothing to destroy (ints, doubles, plain structs): the pool drops its slabs
+		... whole, so clearing 10M ints takes under two hundred deallocations, and with a std::pmr::monotonic_buffer_resource
+		... those are no-ops. Never recursive, so any length of list can be cleared or destroyed.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (!std::is_trivially_destructible<T>::value) {
+			for (Node<T> *current = this->head; current != nullptr;) {
+				Node<T> *next = current->next;
+				this->pool.destroy(current);
+				current = next;
+			}
 		}
+		this->pool.reset();
+		this->index.reset();
+		this->head = nullptr;
 		this->tail = nullptr;
 		this->length = 0;
 	}
@@ -127,42 +904,21 @@ public:
 		*/
 		/// ------------------------------------------------------------------------------------ ///
 
-		std::shared_ptr<Node<T>> current;
-		auto i = 0;
-		if (!(this->head == nullptr)) {
-			current = this->head;
-		}
-		else {
-			std::cout << "nullptr\n";
-			return;
+		if (where < 0 || where >= this->length) {
+			throw nullptrProbed(); // Can't access this value of the list, probe led to nullptr
 		}
 
-		if ((current != nullptr)) {
-			while (!(current->next == nullptr) && i != where) {
-				current = current->next;
-				++i;
-			}
-			if (current->next == nullptr && where + 1 != this->length) {
-				throw nullptrProbed(); // Can't access this value of the list, probe led to nullptr
-			}
-			else {
-				if (where + 1 == this->length) {
-					this->tail = current;
-					--(this->length);
-				}
-				else if (where == 0) {
-					this->head = this->head->next;
-					--(this->length);
-				}
-				else {
-					current->next = current->next->next;
-					--(this->length);
-				}
-			}
+		Node<T> *previous = nodeBefore(where);
+		Node<T> *removed = (previous == nullptr) ? this->head : previous->next;
+		(previous == nullptr ? this->head : previous->next) = removed->next;
+		if (removed == this->tail) {
+			this->tail = previous;
 		}
-		else {
-			return;
+		if (this->indexing == listIndex::skipList) {
+			this->index.unlinked(removed);
 		}
+		this->pool.release(removed);
+		--(this->length);
 	}
 
 
@@ -175,11 +931,8 @@ public:
 		*/
 		/// ------------------------------------------------------------------------------------ ///
 
-		std::shared_ptr<Node<T>> current;
-		if (!(this->head == nullptr)) {
-			current = this->head;
-		}
-		else {
+		Node<T> *current = this->head;
+		if (current == nullptr) {
 			std::cout << "nullptr\n";
 			return;
 		}
@@ -191,86 +944,212 @@ public:
 		std::cout << current->data << ">";
 	}
 
-	void append(T what) {
+	template <typename... Args>
+	T &emplace_back(Args&&... args) {
 
 		/// ------------------------------------------------------------------------------------ ///
 		/*
-		Append a new Node<T> to the end of the list with the value of what.
+		Construct a value from args in a new Node<T> at the end of the list, and return it.
 		*/
 		/// ------------------------------------------------------------------------------------ ///
 
-		std::shared_ptr<Node<T>> end = std::make_shared<Node<T>>();
-		end->data = what;
-		end->next = nullptr;
-		if (this->length != 0) {
+		if (this->indexing == listIndex::skipList) {
+			this->index.seek(this->length - 1, this->head);
+		}
+		Node<T> *end = this->pool.acquire(std::forward<Args>(args)...);
+		if (this->tail == nullptr) {
+			this->head = end;
+		}
+		else {
 			this->tail->next = end;
 		}
+		if (this->indexing == listIndex::skipList) {
+			this->index.linked(this->length, end);
+		}
 		++(this->length);
 		this->tail = end;
+		return end->data;
 	}
 
-	void copyList(const linkedList<T>& other) {
+	void append(const T &what) {
 
 		/// ------------------------------------------------------------------------------------ ///
 		/*
-		Create a deep copy of a list, from other into *this.
+		Append a new Node<T> to the end of the list with the value of what.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		emplace_back(what);
+	}
+
+	void append(T &&what) {
+		emplace_back(std::move(what));
+	}
+
+	template <typename... Args>
+	iterator emplace_after(const_iterator position, Args&&... args) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Construct a value from args in a new Node<T> right after position, which must point into this list.
+		O(1), or O(log n) with a skip index. Returns an iterator to the new value.
 		*/
 		/// ------------------------------------------------------------------------------------ ///
 
-		if (this->head != nullptr) {
-			this->destructList();
+		if (this->indexing == listIndex::skipList) {
+			this->index.seek(position.position, this->head);
 		}
-		if (other.head == nullptr) {
-			this->head = nullptr;
-			this->tail = nullptr;
-			this->length = 0;
+		Node<T> *current = position.node;
+		Node<T> *newNode = this->pool.acquire(std::forward<Args>(args)...);
+		newNode->next = current->next;
+		current->next = newNode;
+		if (current == this->tail) {
+			this->tail = newNode;
 		}
-		else {
-			std::shared_ptr<Node<T>> where = other.head;
-			this->head = std::make_shared<Node<T>>();
-			this->head->data = other.head->data;
-			this->head->next = other.head->next;
-			while (!(where->next == nullptr)) {
-				this->append(where->data);
-				where = where->next;
-			}
-			this->append(where->data);
+		if (this->indexing == listIndex::skipList) {
+			this->index.linked(position.position + 1, newNode);
 		}
+		++(this->length);
+		return iterator(newNode, position.position + 1);
 	}
 
-	void insert(const int &where, T value) {
+	void splice_after(const_iterator position, linkedList &other) {
 
 		/// ------------------------------------------------------------------------------------ ///
 		/*
-		Insert a new Node with the value of value, of type T.
-		The new Node is inserted after iterator int where. Insert at 0 and you will have a new Node at 1.
+		Move all of other's values to right after position, which must point into this list, leaving other empty.
+		When the two allocators share memory (always, for std::allocator) the nodes are relinked in O(1) and this
+		... list takes over the slabs they live in, O(log n) of them. Otherwise each value is moved into a new node.
+		With a skip index the index is rebuilt, O(n).
 		*/
 		/// ------------------------------------------------------------------------------------ ///
 
-		std::shared_ptr<Node<T>> current;
-		int i = 0;
-		if (!(this->head == nullptr)) {
-			current = this->head;
+		if (this == &other || other.head == nullptr) {
+			return;
 		}
-		else {
+		if (this->pool.shares(other.pool)) {
+			relink(position.node, other);
 			return;
 		}
+		for (T &value : other) {
+			position = emplace_after(position, std::move(value));
+		}
+		other.clear();
+	}
 
-		while (!(current->next == nullptr) && i + 1 != where) {
-			current = current->next;
-			++i;
+	void concat(linkedList &other) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Move all of other's values to the end of this list, leaving other empty. Relinks like splice_after.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->tail != nullptr) {
+			splice_after(const_iterator(this->tail, this->length - 1), other);
+		}
+		else if (this != &other && other.head != nullptr) {
+			if (this->pool.shares(other.pool)) {
+				relink(nullptr, other);
+				return;
+			}
+			for (T &value : other) {
+				emplace_back(std::move(value));
+			}
+			other.clear();
+		}
+	}
+
+	void copyList(const linkedList &other) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Create a deep copy of a list, from other into *this.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		this->assign(other.cbegin(), other.length);
+	}
+
+	template <typename Iterator>
+	void assign(Iterator first, const int count) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Replace the contents of the list with count values read from first onwards.
+		All of the nodes come from one allocation and are built in order, so the list is contiguous in memory.
+		A skip index is rebuilt once at the end. If copying a value throws, the list keeps the values copied so far.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		this->clear();
+		if (count <= 0) {
+			return;
+		}
+		Node<T> *block = this->pool.acquireBlock(static_cast<std::size_t>(count));
+		try {
+			for (int i = 0; i < count; ++i, ++first, ++block) {
+				this->pool.construct(block, *first);
+				(this->tail == nullptr ? this->head : this->tail->next) = block;
+				this->tail = block;
+				++(this->length);
+			}
+		}
+		catch (...) {
+			if (this->indexing == listIndex::skipList) {
+				this->index.rebuild(this->head);
+			}
+			throw;
+		}
+		if (this->indexing == listIndex::skipList) {
+			this->index.rebuild(this->head);
+		}
+	}
+
+	template <typename... Args>
+	void emplace(const int where, Args&&... args) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Construct a value from args in a new Node, so that it becomes the Node at iterator int where.
+		Insert at 0 for a new head, at 1 and you will have a new Node at 1, and at the length to append.
+		Exception thrown if we go out of range.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (where < 0 || where > this->length) {
+			throw nullptrProbed(); // Can't access this value of the list, probe led to nullptr
 		}
-		std::shared_ptr<Node<T>> newNode = std::make_shared<Node<T>>();
-		newNode->data = value;
-		newNode->next = current->next;
 		if (where == this->length) {
-			newNode->next = nullptr;
-			this->tail = newNode;
+			emplace_back(std::forward<Args>(args)...);
+			return;
+		}
+
+		Node<T> *current = nodeBefore(where);
+		Node<T> *newNode = this->pool.acquire(std::forward<Args>(args)...);
+		newNode->next = (current == nullptr) ? this->head : current->next;
+		(current == nullptr ? this->head : current->next) = newNode;
+		if (this->indexing == listIndex::skipList) {
+			this->index.linked(where, newNode);
 		}
-		current->next = newNode;
 		++(this->length);
 	}
 
+	void insert(const int &where, const T &value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Insert a new Node with the value of value, of type T, so that it becomes the Node at iterator int where.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		emplace(where, value);
+	}
+
+	void insert(const int &where, T &&value) {
+		emplace(where, std::move(value));
+	}
+
 	int getLength() {
 
 		/// ------------------------------------------------------------------------------------ ///
@@ -325,17 +1204,201 @@ public:
 		*/
 		/// ------------------------------------------------------------------------------------ ///
 
-		std::shared_ptr<Node<T>> current = this->head;
-		int loc = 0;
-		while (current->next != nullptr && loc != i) {
-			current = current->next;
-			++loc;
-		}
-		if (current->next == nullptr && i + 1 != this->length) {
+		if (i < 0 || i >= this->length) {
 			throw nullptrProbed(); // Can't access this value of the list, probe led to nullptr
 		}
-		else {
-			return current->data;
+		return nodeBefore(i + 1)->data;
+	}
+
+	template <typename Compare = std::less<T>>
+	void sort(Compare less = Compare(), const int threads = 0) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Stable merge sort of the list by relinking its nodes: O(n log n), with no T copied or moved.
+		With LINKED_LIST_THREADS set, on a list of at least 2 * parallelSortPart nodes the work is split across
+		... threads (threads = 0 uses one per hardware thread), each sorting a part of at least parallelSortPart
+		... nodes before the parts are merged.
+		less is then called from several threads at once. It must not throw.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+#if LINKED_LIST_THREADS
+		const int available = (threads > 0) ? threads : static_cast<int>(std::thread::hardware_concurrency());
+		const int parts = std::min(available, this->length / parallelSortPart);
+		if (parts >= 2) {
+			this->head = parallelSort(parts, available, less);
+			relinked();
+			return;
+		}
+#else
+		(void)threads;
+#endif
+		this->head = sortChain(this->head, less);
+		relinked();
+	}
+
+	template <typename Compare = std::less<T>>
+	void merge(linkedList &other, Compare less = Compare()) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Merge sorted other into this sorted list, leaving other empty. Stable: of two equal values, this list's
+		... goes first. Nodes are relinked in O(n + m) when the allocators share memory, and the values are moved
+		... over first otherwise.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this == &other || other.head == nullptr) {
+			return;
+		}
+		if (!this->pool.shares(other.pool)) {
+			linkedList moved(listIndex::none, get_allocator());
+			moved.concat(other);
+			merge(moved, less);
+			return;
+		}
+		bool firstLast;
+		this->head = mergeChains(this->head, other.head, less, firstLast);
+		if (!firstLast) {
+			this->tail = other.tail;
+		}
+		this->length += other.length;
+		this->pool.adopt(other.pool);
+		other.index.reset();
+		other.head = nullptr;
+		other.tail = nullptr;
+		other.length = 0;
+		if (this->indexing == listIndex::skipList) {
+			this->index.rebuild(this->head);
+		}
+	}
+
+	template <typename Equal = std::equal_to<T>>
+	int unique(Equal equal = Equal()) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Delete every value equal to the one before it, so each run of equal values keeps only its first.
+		Sort first to remove all duplicates. Returns how many values were deleted.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int removed = 0;
+		Node<T> *current = this->head;
+		while (current != nullptr && current->next != nullptr) {
+			if (equal(current->data, current->next->data)) {
+				Node<T> *duplicate = current->next;
+				current->next = duplicate->next;
+				this->pool.release(duplicate);
+				++removed;
+			}
+			else {
+				current = current->next;
+			}
+		}
+		this->tail = current;
+		this->length -= removed;
+		if (removed > 0 && this->indexing == listIndex::skipList) {
+			this->index.rebuild(this->head);
+		}
+		return removed;
+	}
+
+	void reverse() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Reverse the order of the list by turning every next pointer around.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		Node<T> *previous = nullptr;
+		Node<T> *current = this->head;
+		this->tail = this->head;
+		while (current != nullptr) {
+			Node<T> *next = current->next;
+			current->next = previous;
+			previous = current;
+			current = next;
+		}
+		this->head = previous;
+		if (this->indexing == listIndex::skipList) {
+			this->index.rebuild(this->head);
+		}
+	}
+
+	template <typename Predicate>
+	int find_if(Predicate predicate) const {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Return the index of the first value for which predicate returns true, or -1 if there is none.
+		Every value is a node of its own, so this is a walk from the head; unrolledList searches whole arrays
+		... of values at once.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int position = 0;
+		for (const Node<T> *current = this->head; current != nullptr; current = current->next, ++position) {
+			if (predicate(current->data)) {
+				return position;
+			}
+		}
+		return -1;
+	}
+
+	int find(const T &value) const {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Return the index of the first value equal to value, or -1 if there is none.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		return find_if([&value](const T &each) { return each == value; });
+	}
+
+	int count(const T &value) const {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Return how many values in the list are equal to value.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int found = 0;
+		for (const Node<T> *current = this->head; current != nullptr; current = current->next) {
+			found += (current->data == value) ? 1 : 0;
 		}
+		return found;
+	}
+
+	iterator begin() {
+		return iterator(this->head, 0);
+	}
+
+	iterator end() {
+		return iterator(nullptr, this->length);
+	}
+
+	const_iterator begin() const {
+		return const_iterator(this->head, 0);
+	}
+
+	const_iterator end() const {
+		return const_iterator(nullptr, this->length);
+	}
+
+	const_iterator cbegin() const {
+		return begin();
+	}
+
+	const_iterator cend() const {
+		return end();
+	}
+
+	Allocator get_allocator() const {
+		return this->pool.get_allocator();
 	}
 };
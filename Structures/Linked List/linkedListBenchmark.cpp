@@ -0,0 +1,142 @@
+/// ------------------------------------------------------------------------------------ ///
+/*
+Timing harness for the linked lists. Not a demo, build it with optimizations on:
+g++ -O2 -std=c++17 -pthread linkedListBenchmark.cpp -o linkedListBenchmark
+Pass list sizes as arguments (default 1000 1000000 100000000).
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#define LINKED_LIST_THREADS 1
+#include "linkedList.h"
+#include "unrolledList.h"
+
+double millisecondsSince(const std::chrono::steady_clock::time_point &start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const std::string &name, const std::string &operation, const double milliseconds, const int operations) {
+	std::cout << name << " | " << operation << ": " << milliseconds << " ms, " << \
+		(milliseconds * 1000000.0 / operations) << " ns/op\n";
+}
+
+template <typename List>
+void benchmarkList(const std::string &name, List &L, const int count, const std::vector<int> &positions) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Time appending count values, copying the list and counting a value over the whole list, then at(), insert()
+	... and deleteNode() at the same random positions.
+	Each of the positional calls walks the list from the head, so they show how many nodes a walk touches.
+	The checksum keeps the compiler from dropping the reads.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	auto start = std::chrono::steady_clock::now();
+	L.initList(0);
+	for (int i = 1; i < count; ++i) {
+		L.append(i);
+	}
+	report(name, "append    ", millisecondsSince(start), count);
+
+	start = std::chrono::steady_clock::now();
+	List *copy = new List(L);
+	report(name, "copy      ", millisecondsSince(start), count);
+	delete copy;
+
+	long long checksum = 0;
+	start = std::chrono::steady_clock::now();
+	for (int pass = 0; pass < 10; ++pass) {
+		checksum += L.count(pass);
+	}
+	report(name, "count     ", millisecondsSince(start), count * 10);
+
+	start = std::chrono::steady_clock::now();
+	for (int where : positions) {
+		checksum += L.at(where);
+	}
+	report(name, "at        ", millisecondsSince(start), static_cast<int>(positions.size()));
+
+	start = std::chrono::steady_clock::now();
+	for (int where : positions) {
+		L.insert(where, where);
+	}
+	report(name, "insert    ", millisecondsSince(start), static_cast<int>(positions.size()));
+
+	start = std::chrono::steady_clock::now();
+	for (int where : positions) {
+		L.deleteNode(where);
+	}
+	report(name, "deleteNode", millisecondsSince(start), static_cast<int>(positions.size()));
+	std::cout << "(checksum " << checksum << ", length " << L.getLength() << ")\n";
+	L.destructList();
+}
+
+void benchmarkSort(const int count, std::mt19937 &generator) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Time linkedList::sort on count random ints, on one thread and split across threads, against copying the
+	... values into a std::vector and using std::stable_sort. Each run sorts the same values, in a fresh list.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::vector<int> values(count);
+	for (int &value : values) {
+		value = static_cast<int>(generator());
+	}
+	const int threads = std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+	const int runs[] = { 1, threads };
+	for (int run : runs) {
+		linkedList<int> L;
+		for (int value : values) {
+			L.append(value);
+		}
+		const auto start = std::chrono::steady_clock::now();
+		L.sort(std::less<int>(), run);
+		report("linkedList  ", "sort, " + std::to_string(run) + " thread(s)", millisecondsSince(start), count);
+	}
+
+	std::vector<int> sorted(values);
+	const auto start = std::chrono::steady_clock::now();
+	std::stable_sort(sorted.begin(), sorted.end());
+	report("std::vector ", "stable_sort", millisecondsSince(start), count);
+}
+
+int main(int argc, char **argv) {
+
+	std::vector<int> sizes;
+	for (int i = 1; i < argc; ++i) {
+		sizes.push_back(std::atoi(argv[i]));
+	}
+	if (sizes.empty()) {
+		sizes = { 1000, 1000000, 100000000 };
+	}
+
+	std::mt19937 generator(20181015);
+	for (int count : sizes) {
+		// Every positional call is a walk of about count / 2 steps, so fewer of them on long lists.
+		const int walks = (count <= 1000) ? 1000 : 100;
+		std::vector<int> positions(walks);
+		for (int &where : positions) {
+			where = static_cast<int>(generator() % (count - 1)) + 1;
+		}
+
+		std::cout << "\n" << count << " values, " << walks << " walks to random positions\n";
+		linkedList<int> linked;
+		benchmarkList("linkedList  ", linked, count, positions);
+		linkedList<int> indexed(listIndex::skipList);
+		benchmarkList("skipList    ", indexed, count, positions);
+		unrolledList<int> unrolled;
+		benchmarkList("unrolledList", unrolled, count, positions);
+		benchmarkSort(count, generator);
+	}
+	return 0;
+}
@@ -0,0 +1,112 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include "listSnapshot.h"
+
+double millisecondsSince(const std::chrono::steady_clock::time_point &start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool opens(const char *path) {
+	try {
+		listFileView<int> view(path);
+		return true;
+	}
+	catch (const listFileError &) {
+		return false;
+	}
+}
+
+int main()
+{
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Gain a few insights on how to save and reload a linkedList, and see a testable demo that checks the reloaded
+	list against the one that was saved. Writes (and then deletes) files in the current directory.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::cout << "Build a linkedList as usual, here five million ints:\n";
+	const int count = 5000000;
+	linkedList<int> L;
+	for (int i = 0; i < count; ++i) {
+		L.append(i * 7);
+	}
+	std::cout << "Values: " << L.getLength() << "\n";
+
+	std::cout << "\nsaveList() streams the values out in chunks of 4096 (16 KB each):\n";
+	const char *path = "pokedex.list";
+	auto start = std::chrono::steady_clock::now();
+	saveList(L, path);
+	std::cout << "Saved in " << millisecondsSince(start) << " ms.\n";
+
+	start = std::chrono::steady_clock::now();
+	listFileView<int> view(path);
+	const double opened = millisecondsSince(start);
+	std::cout << "Opening a listFileView only maps the file: " << opened << " ms for " << view.howManyValues() << \
+		" values in " << view.chunkCount() << " chunks.\n";
+	std::cout << "Value at 3 read from the mapped pages: " << view.at(3) << "\n";
+
+	start = std::chrono::steady_clock::now();
+	linkedList<int> Reloaded(listIndex::skipList);
+	loadList(path, Reloaded);
+	std::cout << "loadList() builds all of the nodes (and here a skip index) in one pass: " << \
+		millisecondsSince(start) << " ms.\n";
+
+	std::cout << "\nThe view and the reloaded list must match the saved list value for value: ";
+	bool passed = (view.howManyValues() == count && Reloaded.getLength() == count);
+	linkedList<int>::const_iterator expected = L.cbegin();
+	listFileView<int>::iterator mapped = view.begin();
+	for (const int value : Reloaded) {
+		if (!passed) {
+			break;
+		}
+		passed = (value == *expected && *mapped == *expected);
+		++expected;
+		++mapped;
+	}
+	for (int i = 0; i < count && passed; i += 4093) {
+		passed = (view.at(i) == i * 7 && Reloaded.at(i) == i * 7);
+	}
+	std::cout << (passed ? "passed" : "FAILED") << "\n";
+
+	std::cout << "\nA listWriter can also stream values that were never in a list, and the last chunk may be partial: ";
+	const char *other = "partial.list";
+	{
+		listWriter<int> writer(other, 10);
+		for (int i = 0; i < 25; ++i) {
+			writer.append(-i);
+		}
+	}
+	listFileView<int> partial(other);
+	bool partialPassed = (partial.howManyValues() == 25 && partial.chunkCount() == 3 && partial.chunkLength(2) == 5);
+	for (int i = 0; i < 25 && partialPassed; ++i) {
+		partialPassed = (partial.at(i) == -i);
+	}
+	std::cout << (partialPassed ? "passed" : "FAILED") << "\n";
+
+	std::cout << "\nAn empty list, an unfinished file and a file of another type don't load as this list: ";
+	linkedList<int> Empty;
+	saveList(Empty, other);
+	Reloaded.clear();
+	loadList(other, Reloaded);
+	bool rejected = Reloaded.isEmpty();
+	{
+		listWriter<int> unfinished(other);
+		unfinished.append(1);
+		rejected = rejected && !opens(other);
+	}
+	rejected = rejected && opens(other);
+	linkedList<double> Doubles;
+	Doubles.append(0.5);
+	saveList(Doubles, other);
+	rejected = rejected && !opens(other);
+	std::cout << (rejected ? "passed" : "FAILED") << "\n\n";
+
+	std::remove(path);
+	std::remove(other);
+	passed = passed && partialPassed && rejected;
+	std::cin.get();
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,430 @@
+#pragma once
+/// ------------------------------------------------------------------------------------ ///
+/*
+The following .h file saves a linkedList of trivially copyable values to a flat file and loads it back:
+... a listWriter streams values out in fixed size chunks, a listFileView maps a saved file and reads the
+... values straight from the mapped pages, and loadList() bulk builds a linkedList from such a view.
+POSIX only (open / mmap).
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "linkedList.h"
+
+struct listFileError : public std::exception {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Custom exception. Thrown when a list file can't be written, or a file isn't a list of the expected type.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	const char *message;
+
+	listFileError(const char *messageParam) : message(messageParam) {}
+
+	const char * what() const throw() {
+		return this->message;
+	}
+};
+
+struct listFileHeader {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	The first bytes of a list file, padded to a cache line. The chunks follow, each starting on a cache line:
+	header | chunk 0 | chunk 1 | ... | last chunk
+
+	A chunk is a listChunkHeader and then chunkValues values, back to back. Every chunk but the last is full
+	... and takes chunkBytes, the last one stops right after its final value. The magic is only written once
+	... the writer is closed, so a file that was never finished doesn't open.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	enum : std::uint64_t { bytes = 64 };
+
+	char magic[8];
+	std::uint32_t valueSize;
+	std::uint32_t valueAlignment;
+	std::uint64_t chunkValues;
+	std::uint64_t chunkBytes;
+	std::uint64_t values;
+	std::uint64_t chunks;
+	std::uint64_t fileSize;
+};
+
+struct listChunkHeader {
+	std::uint64_t values;
+	std::uint64_t first; // Position in the list of the chunk's first value.
+};
+
+template <typename T>
+struct listFileLayout {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Where things go in a file of T with chunkValues values per chunk. Shared by the writer and the view.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	static_assert(std::is_trivially_copyable<T>::value, "A list file stores values as raw bytes.");
+	static_assert(alignof(T) <= alignof(listChunkHeader) * 2, "Values start 16 bytes into a cache line.");
+
+	static std::uint64_t chunkBytes(const std::uint64_t chunkValues) {
+		return (sizeof(listChunkHeader) + chunkValues * sizeof(T) + 63) / 64 * 64;
+	}
+
+	static std::uint64_t fileSize(const std::uint64_t chunkValues, const std::uint64_t values) {
+		if (values == 0) {
+			return listFileHeader::bytes;
+		}
+		const std::uint64_t chunks = (values + chunkValues - 1) / chunkValues;
+		const std::uint64_t last = values - (chunks - 1) * chunkValues;
+		return listFileHeader::bytes + (chunks - 1) * chunkBytes(chunkValues) + sizeof(listChunkHeader) + last * sizeof(T);
+	}
+};
+
+template <typename T>
+class listWriter {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Streams values to a list file. Only one chunk is held in memory: it's written out as soon as it fills,
+	... so a list of any length can be saved (or produced on the fly) without a second copy of it.
+	close() writes the last chunk and the header. The destructor closes the file too, but can't report errors.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+private:
+
+	std::ofstream file;
+	std::vector<T> chunk;
+	std::uint64_t chunkValues;
+	std::uint64_t values;
+	std::uint64_t chunks;
+	bool closed;
+
+	void writeChunk() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Write the buffered values as the next chunk. A full chunk is padded to chunkBytes, so the one after
+		... it starts on a cache line. The last chunk never gets here full and unwritten, so it isn't padded.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		static const char padding[64] = {};
+		const listChunkHeader header = { this->chunk.size(), this->values - this->chunk.size() };
+		this->file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		this->file.write(reinterpret_cast<const char *>(this->chunk.data()),
+			static_cast<std::streamsize>(this->chunk.size() * sizeof(T)));
+		if (this->chunk.size() == this->chunkValues) {
+			const std::uint64_t used = sizeof(header) + this->chunkValues * sizeof(T);
+			this->file.write(padding, static_cast<std::streamsize>(listFileLayout<T>::chunkBytes(this->chunkValues) - used));
+		}
+		++(this->chunks);
+		this->chunk.clear();
+	}
+
+public:
+
+	listWriter(const std::string &path, const int chunkValuesParam = 4096) :
+		file(path, std::ios::binary | std::ios::trunc), chunkValues(chunkValuesParam > 0 ? chunkValuesParam : 1),
+		values(0), chunks(0), closed(false) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Create (or truncate) the file at path and leave room for the header. Throws listFileError if it can't.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		static const char blank[listFileHeader::bytes] = {};
+		this->file.write(blank, sizeof(blank));
+		if (!this->file) {
+			throw listFileError("Couldn't create the list file.");
+		}
+		this->chunk.reserve(static_cast<std::size_t>(this->chunkValues));
+	}
+
+	listWriter(const listWriter &) = delete;
+	listWriter &operator=(const listWriter &) = delete;
+
+	~listWriter() {
+		if (!this->closed) {
+			try {
+				close();
+			}
+			catch (const listFileError &) {
+			}
+		}
+	}
+
+	void append(const T &value) {
+		this->chunk.push_back(value);
+		++(this->values);
+		if (this->chunk.size() == this->chunkValues) {
+			writeChunk();
+		}
+	}
+
+	void close() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Write the last, partly filled chunk, then go back and fill in the header. Throws listFileError if any write failed.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->closed) {
+			return;
+		}
+		this->closed = true;
+		if (!this->chunk.empty()) {
+			writeChunk();
+		}
+		listFileHeader header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, "LLSNAP1", 8);
+		header.valueSize = sizeof(T);
+		header.valueAlignment = alignof(T);
+		header.chunkValues = this->chunkValues;
+		header.chunkBytes = listFileLayout<T>::chunkBytes(this->chunkValues);
+		header.values = this->values;
+		header.chunks = this->chunks;
+		header.fileSize = listFileLayout<T>::fileSize(this->chunkValues, this->values);
+		this->file.seekp(0);
+		this->file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		this->file.close();
+		if (!this->file) {
+			throw listFileError("Couldn't write the list file.");
+		}
+	}
+
+	int howManyValues() const {
+		return static_cast<int>(this->values);
+	}
+};
+
+template <typename T, typename Allocator>
+void saveList(const linkedList<T, Allocator> &L, const std::string &path, const int chunkValues = 4096) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Write every value of L to path, in order. Values are stored as raw bytes, so the file is only readable
+	... on machines with the same byte order and type sizes. Throws listFileError if writing fails.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	listWriter<T> writer(path, chunkValues);
+	for (const T &value : L) {
+		writer.append(value);
+	}
+	writer.close();
+}
+
+template <typename T>
+struct listFileIterator {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Forward iterator over the values of a listFileView, hopping from the end of one chunk to the start of the next.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	typedef std::forward_iterator_tag iterator_category;
+	typedef T value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef const T *pointer;
+	typedef const T &reference;
+
+	const char *chunk;
+	std::uint64_t chunkBytes;
+	std::uint64_t chunkValues;
+	std::uint64_t offset; // Index of the value inside its chunk.
+	std::uint64_t position;
+
+	reference operator*() const {
+		return reinterpret_cast<const T *>(this->chunk + sizeof(listChunkHeader))[this->offset];
+	}
+
+	pointer operator->() const {
+		return &(**this);
+	}
+
+	listFileIterator &operator++() {
+		++(this->position);
+		if (++(this->offset) == this->chunkValues) {
+			this->chunk += this->chunkBytes;
+			this->offset = 0;
+		}
+		return *this;
+	}
+
+	listFileIterator operator++(int) {
+		listFileIterator before = *this;
+		++(*this);
+		return before;
+	}
+
+	bool operator==(const listFileIterator &other) const {
+		return this->position == other.position;
+	}
+
+	bool operator!=(const listFileIterator &other) const {
+		return this->position != other.position;
+	}
+};
+
+template <typename T>
+class listFileView {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	A read-only list over a file written by a listWriter. Opening only maps the file and checks its header:
+	... nothing is parsed or copied, values are read from the mapped pages, which are loaded on first touch
+	... and shared by every process that maps the same file. at() finds a value's chunk with a division,
+	... so it's O(1) instead of a walk.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+private:
+
+	void *mapping;
+	std::uint64_t bytes;
+	const char *chunks;
+	std::uint64_t chunkBytes;
+	std::uint64_t chunkValues;
+	std::uint64_t values;
+	std::uint64_t chunkTotal;
+
+public:
+
+	typedef listFileIterator<T> iterator;
+	typedef listFileIterator<T> const_iterator;
+
+	listFileView(const std::string &path) : mapping(nullptr), bytes(0) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Map the file at path. Throws listFileError if it can't be opened, or wasn't written as a complete list of T.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const int descriptor = ::open(path.c_str(), O_RDONLY);
+		if (descriptor < 0) {
+			throw listFileError("Couldn't open the list file.");
+		}
+		struct stat status;
+		if (::fstat(descriptor, &status) != 0 || static_cast<std::uint64_t>(status.st_size) < listFileHeader::bytes) {
+			::close(descriptor);
+			throw listFileError("The file is too small to be a list file.");
+		}
+		this->bytes = static_cast<std::uint64_t>(status.st_size);
+		void *mapped = ::mmap(nullptr, this->bytes, PROT_READ, MAP_SHARED, descriptor, 0);
+		::close(descriptor); // The mapping keeps the file alive.
+		if (mapped == MAP_FAILED) {
+			throw listFileError("Couldn't map the list file.");
+		}
+		this->mapping = mapped;
+
+		const char *base = static_cast<const char *>(this->mapping);
+		const listFileHeader *header = reinterpret_cast<const listFileHeader *>(base);
+		if (std::memcmp(header->magic, "LLSNAP1", 8) != 0 || header->valueSize != sizeof(T) ||
+			header->valueAlignment != alignof(T) || header->chunkValues == 0 ||
+			header->chunkBytes != listFileLayout<T>::chunkBytes(header->chunkValues) ||
+			header->chunks != (header->values + header->chunkValues - 1) / header->chunkValues ||
+			header->fileSize != listFileLayout<T>::fileSize(header->chunkValues, header->values) ||
+			header->fileSize != this->bytes) {
+			::munmap(this->mapping, this->bytes);
+			throw listFileError("The file isn't a complete list file of this value type.");
+		}
+		this->chunks = base + listFileHeader::bytes;
+		this->chunkBytes = header->chunkBytes;
+		this->chunkValues = header->chunkValues;
+		this->values = header->values;
+		this->chunkTotal = header->chunks;
+	}
+
+	listFileView(const listFileView &) = delete;
+	listFileView &operator=(const listFileView &) = delete;
+
+	listFileView(listFileView &&other) noexcept : mapping(other.mapping), bytes(other.bytes), chunks(other.chunks),
+		chunkBytes(other.chunkBytes), chunkValues(other.chunkValues), values(other.values), chunkTotal(other.chunkTotal) {
+		other.mapping = nullptr;
+	}
+
+	~listFileView() {
+		if (this->mapping != nullptr) {
+			::munmap(this->mapping, this->bytes);
+		}
+	}
+
+	const T &at(const int i) const {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Returns the value at index i. If i is out of range, throws nullptrProbed like linkedList::at().
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (i < 0 || static_cast<std::uint64_t>(i) >= this->values) {
+			throw nullptrProbed();
+		}
+		const std::uint64_t position = static_cast<std::uint64_t>(i);
+		return chunk(static_cast<int>(position / this->chunkValues))[position % this->chunkValues];
+	}
+
+	const T *chunk(const int c) const {
+		return reinterpret_cast<const T *>(this->chunks + c * this->chunkBytes + sizeof(listChunkHeader));
+	}
+
+	int chunkLength(const int c) const {
+		return static_cast<int>(reinterpret_cast<const listChunkHeader *>(this->chunks + c * this->chunkBytes)->values);
+	}
+
+	int chunkCount() const {
+		return static_cast<int>(this->chunkTotal);
+	}
+
+	int howManyValues() const {
+		return static_cast<int>(this->values);
+	}
+
+	bool isEmpty() const {
+		return (this->values == 0);
+	}
+
+	iterator begin() const {
+		return { this->chunks, this->chunkBytes, this->chunkValues, 0, 0 };
+	}
+
+	iterator end() const {
+		return { nullptr, this->chunkBytes, this->chunkValues, 0, this->values };
+	}
+};
+
+template <typename T, typename Allocator>
+void loadList(const std::string &path, linkedList<T, Allocator> &L) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Replace the contents of L with the list saved at path. The file is mapped and read once, front to back,
+	... into nodes that all come from one allocation, so loading costs about as much as copying the values.
+	Throws listFileError if the file can't be read as a list of T. L is left untouched in that case.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	listFileView<T> view(path);
+	L.assign(view.begin(), view.howManyValues());
+}
@@ -0,0 +1,214 @@
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "lockFreeList.h"
+
+struct operation {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	One call made during the stress test: what was asked, what came back, and when it started and ended.
+	invoked / responded come from one shared counter, so they order calls across threads.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	int key;
+	char type; // 'i'nsert, 'r'emove or 'c'ontains.
+	bool result;
+	long long invoked;
+	long long responded;
+};
+
+bool linearizable(const std::vector<operation> &history, const int done, const bool present, std::set<std::pair<int, bool>> &seen) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Wing and Gong's check for one key's history (at most 31 calls): is there an order of the calls that
+	... respects real time (a call that ended before another began comes first) and in which every result
+	... matches a sequential set? done is the bitmask of calls already placed, present the key's state.
+	Linearizability is local, so checking every key on its own checks the whole set.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	const int count = static_cast<int>(history.size());
+	if (done == (1 << count) - 1) {
+		return true;
+	}
+	if (!seen.insert({ done, present }).second) {
+		return false; // Already explored from this exact state.
+	}
+
+	for (int i = 0; i < count; ++i) {
+		if (done & (1 << i)) {
+			continue;
+		}
+		bool minimal = true;
+		for (int j = 0; j < count && minimal; ++j) {
+			if (!(done & (1 << j)) && history[j].responded < history[i].invoked) {
+				minimal = false; // j finished before i started, so j has to be placed first.
+			}
+		}
+		if (!minimal) {
+			continue;
+		}
+
+		const operation &call = history[i];
+		bool expected = present, after = present;
+		if (call.type == 'i') {
+			expected = !present;
+			after = true;
+		}
+		else if (call.type == 'r') {
+			after = false;
+		}
+		if (call.result == expected && linearizable(history, done | (1 << i), after, seen)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool stressRound(splitOrderedSet<int> &S, const int firstKey, const int threads, const int callsPerThread, std::atomic<long long> &clock) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Start threads together on a handful of fresh keys, record every call, then check each key's history.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	const int keys = 4;
+	std::vector<std::vector<operation>> recorded(threads);
+	std::atomic<int> ready(0);
+	std::vector<std::thread> workers;
+
+	for (int t = 0; t < threads; ++t) {
+		workers.emplace_back([&, t]() {
+			std::mt19937 generator(firstKey * 31 + t);
+			++ready;
+			while (ready.load() < threads) {
+				std::this_thread::yield();
+			}
+			for (int i = 0; i < callsPerThread; ++i) {
+				operation call;
+				call.key = firstKey + static_cast<int>(generator() % keys);
+				call.type = "irc"[generator() % 3];
+				call.invoked = clock++;
+				if (call.type == 'i') {
+					call.result = S.insert(call.key);
+				}
+				else if (call.type == 'r') {
+					call.result = S.remove(call.key);
+				}
+				else {
+					call.result = S.contains(call.key);
+				}
+				call.responded = clock++;
+				recorded[t].push_back(call);
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+
+	for (int key = firstKey; key < firstKey + keys; ++key) {
+		std::vector<operation> history;
+		for (const std::vector<operation> &calls : recorded) {
+			for (const operation &call : calls) {
+				if (call.key == key) {
+					history.push_back(call);
+				}
+			}
+		}
+		std::set<std::pair<int, bool>> seen;
+		if (!linearizable(history, 0, false, seen)) {
+			std::cout << "Key " << key << " has a history no sequential set could produce!\n";
+			return false;
+		}
+	}
+	return true;
+}
+
+int main()
+{
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Gain a few insights on how to use the lock-free list and set, and see a testable demo that stress tests them
+	from several threads and checks the results. Build with threads enabled:
+	g++ -std=c++17 -pthread lockFreeList.cpp
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::cout << "A lockFreeList keeps unique values sorted, and any number of threads can use it at once.\n";
+	lockFreeList<int> L;
+	L.insert(5); L.insert(2); L.insert(9); L.insert(5);
+	std::cout << "After inserting 5, 2, 9 and 5 again: "; L.print();
+	L.remove(2);
+	std::cout << "\nAfter removing 2: "; L.print();
+	std::cout << " | contains 9: " << L.contains(9) << "\n";
+
+	std::cout << "\nA splitOrderedSet is a lock-free hash set built on the list. It grows by adding buckets, never by moving entries.\n";
+	splitOrderedSet<int> S;
+	for (int i = 0; i < 1000; ++i) {
+		S.insert(i);
+	}
+	std::cout << "Entries: " << S.howManyEntries() << " | Buckets: " << S.howManyBuckets() << \
+		" | contains 999: " << S.contains(999) << " | contains 1000: " << S.contains(1000) << "\n";
+
+	std::cout << "\nStress test 1: four threads insert and remove 1000 shared keys, 100000 calls each.\n" << \
+		"For every key, successful inserts and removes must alternate, and the key must be present at the end exactly\n" << \
+		"when one more insert than remove succeeded: ";
+	splitOrderedSet<int> shared;
+	const int keys = 1000, threads = 4;
+	std::vector<std::vector<int>> net(threads, std::vector<int>(keys, 0));
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; ++t) {
+		workers.emplace_back([&shared, &net, t]() {
+			std::mt19937 generator(t + 1);
+			for (int i = 0; i < 100000; ++i) {
+				const int key = static_cast<int>(generator() % keys);
+				if (generator() % 2) {
+					net[t][key] += shared.insert(key);
+				}
+				else {
+					net[t][key] -= shared.remove(key);
+				}
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	bool passed = true;
+	int present = 0;
+	for (int key = 0; key < keys; ++key) {
+		int total = 0;
+		for (int t = 0; t < threads; ++t) {
+			total += net[t][key];
+		}
+		if ((total != 0 && total != 1) || shared.contains(key) != (total == 1)) {
+			passed = false;
+		}
+		present += total;
+	}
+	passed = passed && (present == shared.howManyEntries());
+	std::cout << (passed ? "passed" : "FAILED") << "\n";
+
+	std::cout << "\nStress test 2: 2000 rounds of four threads racing on four fresh keys. Every key's history of calls\n" << \
+		"is checked for linearizability (some order of the calls, respecting real time, gives the same results): ";
+	splitOrderedSet<int> checked;
+	std::atomic<long long> clock(0);
+	bool linearized = true;
+	for (int round = 0; round < 2000 && linearized; ++round) {
+		linearized = stressRound(checked, round * 4, 4, 6, clock);
+	}
+	std::cout << (linearized ? "passed" : "FAILED") << "\n\n";
+
+	std::cin.get();
+	return (passed && linearized) ? 0 : 1;
+}
@@ -0,0 +1,652 @@
+#pragma once
+
+/// ------------------------------------------------------------------------------------ ///
+/*
+The following .h file includes a lock-free ordered linked list (Harris-Michael) with hazard pointer memory
+reclamation, and a lock-free split-ordered hash set (Shalev-Shavit) built on top of it.
+Build with threads enabled, e.g. -pthread.
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+struct hazardPointers {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Michael's hazard pointers, the memory reclamation for the lock-free list.
+	A thread that is about to read a node publishes its address in one of its hazard slots. A removed node is
+	... "retired" instead of deleted, and only deleted once no thread's hazard slot holds its address.
+	Every thread gets a record the first time it touches a lock-free structure, and hands it back on exit.
+	There is one domain for the whole program, shared by every list and set.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	enum : int { perThread = 3, retireThreshold = 64 };
+
+	struct retired {
+		void *pointer;
+		void (*destroy)(void *);
+	};
+
+	struct record {
+		std::atomic<void *> hazards[perThread];
+		std::atomic<bool> active;
+		record *next;
+		std::vector<retired> retiredList; // Only touched by the owning thread, or by the domain at exit.
+
+		record() : active(true), next(nullptr) {
+			for (std::atomic<void *> &hazard : this->hazards) {
+				hazard.store(nullptr);
+			}
+		}
+	};
+
+	std::atomic<record *> records;
+
+	hazardPointers() : records(nullptr) {}
+
+	~hazardPointers() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		At program exit no thread can still be reading, so everything still retired is freed.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		record *current = this->records.load();
+		while (current != nullptr) {
+			record *next = current->next;
+			for (retired &node : current->retiredList) {
+				node.destroy(node.pointer);
+			}
+			delete current;
+			current = next;
+		}
+	}
+
+	static hazardPointers &domain() {
+		static hazardPointers instance;
+		return instance;
+	}
+
+	static record &mine() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		The calling thread's record. The thread_local owner releases it when the thread exits, leaving its
+		... retired nodes for the next thread to take the record (or for the domain at exit).
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		struct owner {
+			record *held;
+			owner() : held(domain().acquire()) {}
+			~owner() {
+				for (std::atomic<void *> &hazard : this->held->hazards) {
+					hazard.store(nullptr);
+				}
+				this->held->active.store(false);
+			}
+		};
+		thread_local owner current;
+		return *(current.held);
+	}
+
+	record *acquire() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Reuse a record a finished thread gave back, else push a new one. Records are never unlinked.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		for (record *current = this->records.load(); current != nullptr; current = current->next) {
+			bool expected = false;
+			if (!current->active.load() && current->active.compare_exchange_strong(expected, true)) {
+				return current;
+			}
+		}
+		record *fresh = new record();
+		record *head = this->records.load();
+		do {
+			fresh->next = head;
+		} while (!this->records.compare_exchange_weak(head, fresh));
+		return fresh;
+	}
+
+	static void clear() {
+		for (std::atomic<void *> &hazard : mine().hazards) {
+			hazard.store(nullptr);
+		}
+	}
+
+	void retire(void *pointer, void (*destroy)(void *)) {
+		record &owner = mine();
+		owner.retiredList.push_back({ pointer, destroy });
+		if (static_cast<int>(owner.retiredList.size()) >= retireThreshold) {
+			scan(owner);
+		}
+	}
+
+	void scan(record &owner) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Gather every published hazard, then delete the retired nodes nobody is protecting.
+		O(R log H) for R retired nodes and H hazards.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		std::vector<void *> protectedNodes;
+		for (record *current = this->records.load(); current != nullptr; current = current->next) {
+			for (std::atomic<void *> &hazard : current->hazards) {
+				void *pointer = hazard.load();
+				if (pointer != nullptr) {
+					protectedNodes.push_back(pointer);
+				}
+			}
+		}
+		std::sort(protectedNodes.begin(), protectedNodes.end());
+
+		std::vector<retired> stillProtected;
+		for (retired &node : owner.retiredList) {
+			if (std::binary_search(protectedNodes.begin(), protectedNodes.end(), node.pointer)) {
+				stillProtected.push_back(node);
+			}
+			else {
+				node.destroy(node.pointer);
+			}
+		}
+		owner.retiredList.swap(stillProtected);
+	}
+};
+
+template <typename T, typename Hash>
+class splitOrderedSet;
+
+template <typename T>
+class lockFreeList {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Lock-free sorted list of unique T values, any number of threads may insert, remove and search at once.
+	T needs operator< and operator==, values equivalent under < are kept next to each other.
+
+	Removal is two steps (Harris): first the low bit of the node's own next pointer is set ("marked"), so no
+	... insertion can link after it, then the node is unlinked with a CAS on its predecessor. Any thread that
+	... walks past a marked node unlinks it for the remover (Michael), and retires it to the hazard pointers.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+public:
+
+	struct node {
+		T data;
+		std::atomic<std::uintptr_t> next; // Next node, the low bit marks this node as removed.
+
+		explicit node(const T &value) : data(value), next(0) {}
+	};
+
+private:
+
+	template <typename, typename> friend class splitOrderedSet;
+
+	struct position {
+		std::atomic<std::uintptr_t> *previous;
+		node *current;
+		std::uintptr_t next;
+	};
+
+	node head; // Sentinel before the first value, never removed.
+	std::atomic<int> length;
+
+	static bool isMarked(const std::uintptr_t link) {
+		return (link & 1) != 0;
+	}
+
+	static node *pointerOf(const std::uintptr_t link) {
+		return reinterpret_cast<node *>(link & ~static_cast<std::uintptr_t>(1));
+	}
+
+	static std::uintptr_t linkTo(node *target) {
+		return reinterpret_cast<std::uintptr_t>(target);
+	}
+
+	static void destroyNode(void *pointer) {
+		delete static_cast<node *>(pointer);
+	}
+
+	bool find(node *start, const T &value, position &at) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Walk from start to the first node not less than value, unlinking marked nodes on the way.
+		Hazard slots: 0 protects next, 1 protects current, 2 protects the node owning previous.
+		Every time a link is found to have changed under us, the walk restarts from start.
+		On return, at.current is value's node (true) or the node value would be inserted before (false).
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		hazardPointers::record &me = hazardPointers::mine();
+
+		while (true) {
+			std::atomic<std::uintptr_t> *previous = &start->next;
+			node *current = pointerOf(previous->load());
+			bool restart = false;
+
+			while (!restart) {
+				me.hazards[1].store(current);
+				if (previous->load() != linkTo(current)) {
+					restart = true; // previous changed or was marked, current may already be gone.
+					break;
+				}
+				if (current == nullptr) {
+					at = { previous, nullptr, 0 };
+					return false;
+				}
+
+				const std::uintptr_t next = current->next.load();
+				me.hazards[0].store(pointerOf(next));
+				if (current->next.load() != next || previous->load() != linkTo(current)) {
+					restart = true;
+					break;
+				}
+
+				if (!isMarked(next)) {
+					if (value < current->data) {
+						at = { previous, current, next };
+						return false;
+					}
+					else if (current->data == value) {
+						at = { previous, current, next };
+						return true;
+					}
+					previous = &current->next;
+					me.hazards[2].store(current);
+				}
+				else {
+					// current was removed but is still linked. Unlink it for the remover.
+					std::uintptr_t expected = linkTo(current);
+					if (previous->compare_exchange_strong(expected, linkTo(pointerOf(next)))) {
+						hazardPointers::domain().retire(current, destroyNode);
+					}
+					else {
+						restart = true;
+						break;
+					}
+				}
+				current = pointerOf(next);
+			}
+		}
+	}
+
+	node *insertFrom(node *start, node *fresh, bool &inserted) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Link fresh into place after start. If an equal value is already there, fresh is left unlinked and
+		... the existing node is returned instead (it stays protected until the caller's next operation).
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		position at;
+		while (true) {
+			if (find(start, fresh->data, at)) {
+				inserted = false;
+				return at.current;
+			}
+			fresh->next.store(linkTo(at.current));
+			std::uintptr_t expected = linkTo(at.current);
+			if (at.previous->compare_exchange_strong(expected, linkTo(fresh))) {
+				++(this->length);
+				inserted = true;
+				return fresh;
+			}
+		}
+	}
+
+	bool removeFrom(node *start, const T &value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Mark value's node, then try to unlink it. Whoever wins the mark owns the removal, if the unlink CAS
+		... loses a race another find() finishes it.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		position at;
+		while (true) {
+			if (!find(start, value, at)) {
+				hazardPointers::clear();
+				return false;
+			}
+			std::uintptr_t next = at.next;
+			if (!at.current->next.compare_exchange_strong(next, next | 1)) {
+				continue; // Its next changed, or someone else marked it first.
+			}
+			--(this->length);
+			std::uintptr_t expected = linkTo(at.current);
+			if (at.previous->compare_exchange_strong(expected, next)) {
+				hazardPointers::domain().retire(at.current, destroyNode);
+			}
+			else {
+				find(start, value, at);
+			}
+			hazardPointers::clear();
+			return true;
+		}
+	}
+
+	bool containsFrom(node *start, const T &value) {
+		position at;
+		const bool found = find(start, value, at);
+		hazardPointers::clear();
+		return found;
+	}
+
+public:
+
+	lockFreeList() : head(T()), length(0) {}
+
+	lockFreeList(const lockFreeList &) = delete;
+	lockFreeList &operator=(const lockFreeList &) = delete;
+
+	~lockFreeList() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Free every linked node. No other thread may use the list anymore. Already retired nodes belong to
+		... the hazard pointer domain.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		node *current = pointerOf(this->head.next.load());
+		while (current != nullptr) {
+			node *next = pointerOf(current->next.load());
+			delete current;
+			current = next;
+		}
+	}
+
+	bool insert(const T &value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Insert value in order. Returns false if it was already in the list.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		node *fresh = new node(value);
+		bool inserted = false;
+		insertFrom(&this->head, fresh, inserted);
+		hazardPointers::clear();
+		if (!inserted) {
+			delete fresh; // Never linked, no other thread can have seen it.
+		}
+		return inserted;
+	}
+
+	bool remove(const T &value) {
+		return removeFrom(&this->head, value);
+	}
+
+	bool contains(const T &value) {
+		return containsFrom(&this->head, value);
+	}
+
+	int getLength() {
+		return this->length.load();
+	}
+
+	void print() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Print the list like linkedList::print. Only meaningful while no other thread is writing.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		std::cout << "<";
+		bool first = true;
+		for (node *current = pointerOf(this->head.next.load()); current != nullptr; current = pointerOf(current->next.load())) {
+			if (!isMarked(current->next.load())) {
+				std::cout << (first ? "" : ", ") << current->data;
+				first = false;
+			}
+		}
+		std::cout << ">";
+	}
+};
+
+template <typename T, typename Hash = std::hash<T>>
+class splitOrderedSet {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Lock-free hash set (Shalev and Shavit, "Split-Ordered Lists"). All values live in one lockFreeList,
+	... sorted by their hash with the bits reversed. Reversed, the entries of bucket b (hash % 2^k == b) sit
+	... together, and doubling the bucket count splits every bucket in place: the new bucket b + 2^k starts
+	... in the middle of bucket b. So the table grows without ever moving an entry.
+
+	Each bucket is a pointer to a dummy node in the list, where searches for that bucket start. Buckets are
+	... created lazily by inserting their dummy after their parent's, and published with a CAS. The bucket
+	... directory is a fixed array of lazily allocated segments, so it never needs to be copied either.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+private:
+
+	struct entry {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		order is the bit reversed hash: odd for values, even for bucket dummies. Values whose hashes reverse
+		... to the same order are told apart by ==.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		std::uint64_t order;
+		T value;
+
+		bool operator<(const entry &other) const {
+			return this->order < other.order;
+		}
+
+		bool operator==(const entry &other) const {
+			return this->order == other.order && ((this->order & 1) == 0 || this->value == other.value);
+		}
+
+		friend std::ostream &operator<<(std::ostream &out, const entry &item) {
+			return out << item.value;
+		}
+	};
+
+	typedef typename lockFreeList<entry>::node node;
+
+	enum : int { segmentBits = 12, segmentSize = 1 << segmentBits, maxSegments = 1 << 12, maxLoad = 2 };
+
+	lockFreeList<entry> list;
+	std::atomic<std::atomic<node *> *> segments[maxSegments];
+	std::atomic<int> bucketCount; // Always a power of two.
+	std::atomic<int> entries;
+	Hash hasher;
+
+	static std::uint64_t reverseBits(std::uint64_t bits) {
+		bits = ((bits >> 1) & 0x5555555555555555ull) | ((bits & 0x5555555555555555ull) << 1);
+		bits = ((bits >> 2) & 0x3333333333333333ull) | ((bits & 0x3333333333333333ull) << 2);
+		bits = ((bits >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((bits & 0x0F0F0F0F0F0F0F0Full) << 4);
+		bits = ((bits >> 8) & 0x00FF00FF00FF00FFull) | ((bits & 0x00FF00FF00FF00FFull) << 8);
+		bits = ((bits >> 16) & 0x0000FFFF0000FFFFull) | ((bits & 0x0000FFFF0000FFFFull) << 16);
+		return (bits >> 32) | (bits << 32);
+	}
+
+	std::uint64_t hash(const T &value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Hash with the murmur3 finalizer on top, like hashMixer, so the low bits used for buckets are mixed.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		std::uint64_t hashed = static_cast<std::uint64_t>(this->hasher(value));
+		hashed ^= hashed >> 33;
+		hashed *= 0xFF51AFD7ED558CCDull;
+		hashed ^= hashed >> 33;
+		hashed *= 0xC4CEB9FE1A85EC53ull;
+		hashed ^= hashed >> 33;
+		return hashed;
+	}
+
+	node *getBucket(const int bucket) {
+		std::atomic<node *> *segment = this->segments[bucket >> segmentBits].load();
+		return (segment == nullptr) ? nullptr : segment[bucket & (segmentSize - 1)].load();
+	}
+
+	void setBucket(const int bucket, node *dummy) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Publish a bucket's dummy, allocating its segment first if needed. Losing the segment CAS just means
+		... another thread allocated it, ours is thrown away.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		std::atomic<std::atomic<node *> *> &slot = this->segments[bucket >> segmentBits];
+		std::atomic<node *> *segment = slot.load();
+		if (segment == nullptr) {
+			std::atomic<node *> *fresh = new std::atomic<node *>[segmentSize];
+			for (int i = 0; i < segmentSize; ++i) {
+				fresh[i].store(nullptr);
+			}
+			if (slot.compare_exchange_strong(segment, fresh)) {
+				segment = fresh;
+			}
+			else {
+				delete[] fresh;
+			}
+		}
+		segment[bucket & (segmentSize - 1)].store(dummy);
+	}
+
+	node *initializeBucket(const int bucket) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		A bucket's parent is the bucket it split from, itself with the top set bit cleared. The dummy is
+		... inserted starting from the parent's dummy, initializing the parent first if needed.
+		If another thread's dummy won, that one is published instead. Dummies are never removed.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int parent = bucket;
+		for (int bit = 1; bit <= bucket; bit <<= 1) {
+			if (bucket & bit) {
+				parent = bucket & ~bit; // Ends on the highest set bit.
+			}
+		}
+		node *start = getBucket(parent);
+		if (start == nullptr) {
+			start = initializeBucket(parent);
+		}
+
+		node *dummy = new node(entry{ reverseBits(static_cast<std::uint64_t>(bucket)), T() });
+		bool inserted = false;
+		node *actual = this->list.insertFrom(start, dummy, inserted);
+		hazardPointers::clear();
+		if (!inserted) {
+			delete dummy;
+		}
+		setBucket(bucket, actual);
+		return actual;
+	}
+
+	node *bucketStart(const std::uint64_t hashed) {
+		const int bucket = static_cast<int>(hashed & static_cast<std::uint64_t>(this->bucketCount.load() - 1));
+		node *start = getBucket(bucket);
+		return (start == nullptr) ? initializeBucket(bucket) : start;
+	}
+
+public:
+
+	splitOrderedSet() : bucketCount(2), entries(0) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Bucket 0's dummy is the list's own head sentinel, every other bucket is created on first use.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		for (std::atomic<std::atomic<node *> *> &segment : this->segments) {
+			segment.store(nullptr);
+		}
+		setBucket(0, &this->list.head);
+	}
+
+	splitOrderedSet(const splitOrderedSet &) = delete;
+	splitOrderedSet &operator=(const splitOrderedSet &) = delete;
+
+	~splitOrderedSet() {
+		for (std::atomic<std::atomic<node *> *> &segment : this->segments) {
+			delete[] segment.load();
+		}
+	}
+
+	bool insert(const T &value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Insert value. Returns false if it was already in the set.
+		Past maxLoad values per bucket, the bucket count doubles with a single CAS, nothing is moved.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const std::uint64_t hashed = hash(value);
+		node *fresh = new node(entry{ reverseBits(hashed) | 1, value });
+		bool inserted = false;
+		this->list.insertFrom(bucketStart(hashed), fresh, inserted);
+		hazardPointers::clear();
+		if (!inserted) {
+			delete fresh;
+			return false;
+		}
+
+		const int count = ++(this->entries);
+		int buckets = this->bucketCount.load();
+		if (count / buckets > maxLoad && buckets < segmentSize * maxSegments) {
+			this->bucketCount.compare_exchange_strong(buckets, buckets * 2);
+		}
+		return true;
+	}
+
+	bool remove(const T &value) {
+		const std::uint64_t hashed = hash(value);
+		if (this->list.removeFrom(bucketStart(hashed), entry{ reverseBits(hashed) | 1, value })) {
+			--(this->entries);
+			return true;
+		}
+		return false;
+	}
+
+	bool contains(const T &value) {
+		const std::uint64_t hashed = hash(value);
+		return this->list.containsFrom(bucketStart(hashed), entry{ reverseBits(hashed) | 1, value });
+	}
+
+	int howManyEntries() {
+		return this->entries.load();
+	}
+
+	int howManyBuckets() {
+		return this->bucketCount.load();
+	}
+
+	bool isEmpty() {
+		return (this->entries.load() == 0);
+	}
+};
@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "unrolledList.h"
+
+bool matchesVector(const int rounds) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Random appends, inserts and deletes on an unrolledList<int> and a std::vector, compared after every call.
+	A small capacity makes nodes split and merge often.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	unrolledList<int, 4> U;
+	std::vector<int> expected;
+	std::mt19937 generator(16);
+	for (int i = 0; i < rounds; ++i) {
+		const int choice = static_cast<int>(generator() % 4);
+		if (choice == 0 || expected.empty()) {
+			U.append(i);
+			expected.push_back(i);
+		}
+		else if (choice == 1) {
+			const int where = static_cast<int>(generator() % (expected.size() + 1));
+			U.insert(where, i);
+			expected.insert(expected.begin() + where, i);
+		}
+		else {
+			const int where = static_cast<int>(generator() % expected.size());
+			U.deleteNode(where);
+			expected.erase(expected.begin() + where);
+		}
+		// With 4 values per node, every node but the last holds at least 2.
+		if (U.getLength() != static_cast<int>(expected.size()) || U.nodeCount() > (U.getLength() + 1) / 2) {
+			return false;
+		}
+		if (!expected.empty()) {
+			const int probe = static_cast<int>(generator() % expected.size());
+			if (U.at(probe) != expected[probe] || U.top() != expected.front() || U.back() != expected.back()) {
+				return false;
+			}
+		}
+	}
+	unrolledList<int, 4> copy;
+	copy = U;
+	for (int i = 0; i < static_cast<int>(expected.size()); ++i) {
+		if (copy.at(i) != expected[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool staysHalfFull(const int stride) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Fill a list, then delete all but every stride-th value, front to back. Every node but the last must
+	... still be at least half full, so the list needs at most about twice the nodes of a packed one.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	unrolledList<int> U;
+	const int half = unrolledDefaults<int>::capacity / 2;
+	for (int i = 0; i < 100000; ++i) {
+		U.append(i);
+	}
+	for (int kept = 0; kept < U.getLength(); ++kept) {
+		for (int gone = 1; gone < stride && kept + 1 < U.getLength(); ++gone) {
+			U.deleteNode(kept + 1);
+		}
+	}
+	for (int i = 0; i < U.getLength(); ++i) {
+		if (U.at(i) != i * stride) {
+			return false;
+		}
+	}
+	return U.nodeCount() <= (U.getLength() - 1) / half + 1;
+}
+
+template <typename T>
+bool searchMatchesVector(const int rounds) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	find(), find_if() and count() on an unrolledList<T> against std::find and std::count on a std::vector,
+	... with values from a small range so most of them repeat. Nodes of every fill level get searched,
+	... so both the vector compares and the one value at a time tails are used.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	unrolledList<T> U;
+	std::vector<T> expected;
+	std::mt19937 generator(24);
+	for (int i = 0; i < rounds; ++i) {
+		const T value = static_cast<T>(generator() % 50) - static_cast<T>(10);
+		const int where = static_cast<int>(generator() % (expected.size() + 1));
+		U.insert(where, value);
+		expected.insert(expected.begin() + where, value);
+		if (i % 3 == 0) {
+			const int gone = static_cast<int>(generator() % expected.size());
+			U.deleteNode(gone);
+			expected.erase(expected.begin() + gone);
+		}
+
+		const T wanted = static_cast<T>(generator() % 60) - static_cast<T>(10);
+		const auto found = std::find(expected.begin(), expected.end(), wanted);
+		const int index = (found == expected.end()) ? -1 : static_cast<int>(found - expected.begin());
+		const auto above = [&wanted](const T &each) { return each > wanted; };
+		const auto foundAbove = std::find_if(expected.begin(), expected.end(), above);
+		const int indexAbove = (foundAbove == expected.end()) ? -1 : static_cast<int>(foundAbove - expected.begin());
+		if (U.find(wanted) != index || U.find_if(above) != indexAbove ||
+			U.count(wanted) != static_cast<int>(std::count(expected.begin(), expected.end(), wanted))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int main()
+{
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Gain a few insights on how to use the unrolled list, and see a testable demo that checks it against std::vector.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::cout << "An unrolledList is used like a linkedList, but each node holds up to 28 ints:\n";
+	unrolledList<int> List;
+	List.initList(4);
+	List.append(5);
+	List.append(6);
+	List.append(7);
+	List.insert(1, 2);
+	std::cout << "After appending 5, 6, 7 and inserting 2 at i = 1: ";
+	List.print();
+	List.deleteNode(0);
+	std::cout << "\nAfter deleteNode at 0: ";
+	List.print();
+	std::cout << "\nValue at 2: " << List.at(2) << "\n";
+
+	for (int i = 0; i < 1000; ++i) {
+		List.append(i);
+	}
+	std::cout << "\nAfter 1000 more appends there are " << List.getLength() << " values in only " << \
+		List.nodeCount() << " nodes, so at(1000) walks " << List.nodeCount() << " nodes instead of 1000.\n";
+
+	std::cout << "\nfind and count compare a whole node of values at once: 500 is at index " << List.find(500) << \
+		", and 7 appears " << List.count(7) << " times.\n";
+
+	std::cout << "\nOut of range access throws nullptrProbed: ";
+	bool threw = false;
+	try {
+		List.at(List.getLength());
+	}
+	catch (const nullptrProbed &error) {
+		threw = true;
+		std::cout << error.what() << "\n";
+	}
+
+	std::cout << "\nRandom appends, inserts and deletes compared against std::vector: ";
+	bool passed = threw && matchesVector(100000);
+	std::cout << (passed ? "passed" : "FAILED") << "\n";
+
+	std::cout << "\nDeleting all but every 2nd, 3rd or 7th value keeps every node but the last at least half full: ";
+	passed = passed && staysHalfFull(2) && staysHalfFull(3) && staysHalfFull(7);
+	std::cout << (passed ? "passed" : "FAILED") << "\n";
+
+	std::cout << "\nfind, find_if and count over lists of 8, 16, 32 and 64 bit ints, floats and doubles: ";
+	passed = passed && searchMatchesVector<std::int8_t>(5000) && searchMatchesVector<std::uint16_t>(5000) &&
+		searchMatchesVector<int>(5000) && searchMatchesVector<long long>(5000) && searchMatchesVector<float>(5000) &&
+		searchMatchesVector<double>(5000);
+	std::cout << (passed ? "passed" : "FAILED") << "\n\n";
+
+	std::cin.get();
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,670 @@
+#pragma once
+
+/// ------------------------------------------------------------------------------------ ///
+/*
+The following .h file includes an unrolled linked list: a linked list whose nodes each hold a small array of
+values instead of a single one. Same interface as linkedList.
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <iostream>
+#include <cstdint>
+#include <exception>
+#include <type_traits>
+
+// find() and count() compare whole nodes of arithmetic values at once, with AVX2 when the compiler targets it
+// ... (e.g. -mavx2 or -march=native) and SSE2 otherwise. Define UNROLLED_LIST_SIMD as 0 (before including, or with
+// ... -DUNROLLED_LIST_SIMD=0) to search with plain loops.
+#ifndef UNROLLED_LIST_SIMD
+#define UNROLLED_LIST_SIMD 1
+#endif
+
+#if UNROLLED_LIST_SIMD && defined(__AVX2__)
+#include <immintrin.h>
+#define UNROLLED_LIST_AVX2 1
+#else
+#define UNROLLED_LIST_AVX2 0
+#endif
+
+#if UNROLLED_LIST_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define UNROLLED_LIST_SSE2 1
+#else
+#define UNROLLED_LIST_SSE2 0
+#endif
+
+#include "../nullptrProbed.h"
+
+template <typename T, int Capacity>
+struct alignas(64) unrolledNode {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	A node of the unrolled list, holding up to Capacity values in order. Cache line aligned, so the
+	... values start right after the 16 byte header and a node spans whole lines.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	unrolledNode *next;
+	int count;
+	T items[Capacity];
+
+	unrolledNode() : next(nullptr), count(0) {}
+};
+
+template <typename T>
+struct unrolledDefaults {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Default values per node: as many as fit in two cache lines after the header, at least 4.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	enum : int { capacity = ((128 - 16) / static_cast<int>(sizeof(T)) < 4) ? 4 : (128 - 16) / static_cast<int>(sizeof(T)) };
+};
+
+template <typename T>
+struct chunkSearch {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Search an array of values for one value. For arithmetic T the array is compared a vector register at a time
+	... (32 bytes with AVX2, 16 with SSE2), and the compare sets every byte of each equal value. find() turns that
+	... into one bit per byte with movemask, so a value spans sizeof(T) bits of the mask. count() adds the set bytes
+	... up in the register instead, since a popcount instruction isn't part of SSE2 or AVX2.
+	The tail that doesn't fill a register, and every other T, is compared one value at a time with operator==.
+	Floats compare like operator== too: NaN never matches, and 0.0 matches -0.0.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+#if UNROLLED_LIST_AVX2
+	typedef __m256i lane;
+	enum : int { registerBytes = 32 };
+#elif UNROLLED_LIST_SSE2
+	typedef __m128i lane;
+	enum : int { registerBytes = 16 };
+#else
+	typedef int lane;
+	enum : int { registerBytes = 16 };
+#endif
+
+	enum : int { lanes = registerBytes / static_cast<int>(sizeof(T)) };
+
+	static constexpr bool vectorized = (UNROLLED_LIST_AVX2 || UNROLLED_LIST_SSE2) && std::is_arithmetic<T>::value &&
+		!std::is_same<T, bool>::value && sizeof(T) <= 8;
+
+	static lane equalBytes(const T *items, const T &value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Compare the lanes values starting at items with value. Every byte of an equal value is set, the rest are 0.
+		Only called when vectorized.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+#if UNROLLED_LIST_AVX2
+		if constexpr (std::is_same<T, float>::value) {
+			return _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(items), _mm256_set1_ps(value), _CMP_EQ_OQ));
+		}
+		else if constexpr (std::is_same<T, double>::value) {
+			return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_loadu_pd(items), _mm256_set1_pd(value), _CMP_EQ_OQ));
+		}
+		else {
+			const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(items));
+			if constexpr (sizeof(T) == 1) {
+				return _mm256_cmpeq_epi8(values, _mm256_set1_epi8(static_cast<char>(value)));
+			}
+			else if constexpr (sizeof(T) == 2) {
+				return _mm256_cmpeq_epi16(values, _mm256_set1_epi16(static_cast<short>(value)));
+			}
+			else if constexpr (sizeof(T) == 4) {
+				return _mm256_cmpeq_epi32(values, _mm256_set1_epi32(static_cast<int>(value)));
+			}
+			else {
+				return _mm256_cmpeq_epi64(values, _mm256_set1_epi64x(static_cast<long long>(value)));
+			}
+		}
+#elif UNROLLED_LIST_SSE2
+		if constexpr (std::is_same<T, float>::value) {
+			return _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(items), _mm_set1_ps(value)));
+		}
+		else if constexpr (std::is_same<T, double>::value) {
+			return _mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(items), _mm_set1_pd(value)));
+		}
+		else {
+			const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(items));
+			if constexpr (sizeof(T) == 1) {
+				return _mm_cmpeq_epi8(values, _mm_set1_epi8(static_cast<char>(value)));
+			}
+			else if constexpr (sizeof(T) == 2) {
+				return _mm_cmpeq_epi16(values, _mm_set1_epi16(static_cast<short>(value)));
+			}
+			else if constexpr (sizeof(T) == 4) {
+				return _mm_cmpeq_epi32(values, _mm_set1_epi32(static_cast<int>(value)));
+			}
+			else {
+				// SSE2 has no 64-bit compare: a value is equal when both of its 32-bit halves are.
+				const __m128i halves = _mm_cmpeq_epi32(values, _mm_set1_epi64x(static_cast<long long>(value)));
+				return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+			}
+		}
+#else
+		(void)items;
+		(void)value;
+		return 0;
+#endif
+	}
+
+	static std::uint32_t byteMask(const lane equal) {
+#if UNROLLED_LIST_AVX2
+		return static_cast<std::uint32_t>(_mm256_movemask_epi8(equal));
+#elif UNROLLED_LIST_SSE2
+		return static_cast<std::uint32_t>(_mm_movemask_epi8(equal));
+#else
+		return static_cast<std::uint32_t>(equal);
+#endif
+	}
+
+	static int lowestBit(const std::uint32_t mask) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Index of the lowest set bit of a non-zero mask.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctz(mask);
+#else
+		int bit = 0;
+		while (!(mask & (1u << bit))) {
+			++bit;
+		}
+		return bit;
+#endif
+	}
+
+	static int find(const T *items, const int length, const T &value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Index of the first of length values equal to value, or -1.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int i = 0;
+		if constexpr (vectorized) {
+			for (; i + lanes <= length; i += lanes) {
+				const std::uint32_t mask = byteMask(equalBytes(items + i, value));
+				if (mask != 0) {
+					return i + lowestBit(mask) / static_cast<int>(sizeof(T));
+				}
+			}
+		}
+		for (; i < length; ++i) {
+			if (items[i] == value) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	static int count(const T *items, const int length, const T &value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		How many of length values equal value. Each compare's set bytes are turned into 1s and summed into
+		... 64-bit counters with sad (sum of absolute differences against zero), which can't overflow.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int i = 0, found = 0;
+#if UNROLLED_LIST_AVX2 || UNROLLED_LIST_SSE2
+		if constexpr (vectorized) {
+			std::uint64_t sums[registerBytes / 8];
+#if UNROLLED_LIST_AVX2
+			const __m256i ones = _mm256_set1_epi8(1), zero = _mm256_setzero_si256();
+			__m256i total = zero;
+			for (; i + lanes <= length; i += lanes) {
+				total = _mm256_add_epi64(total, _mm256_sad_epu8(_mm256_and_si256(equalBytes(items + i, value), ones), zero));
+			}
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(sums), total);
+#else
+			const __m128i ones = _mm_set1_epi8(1), zero = _mm_setzero_si128();
+			__m128i total = zero;
+			for (; i + lanes <= length; i += lanes) {
+				total = _mm_add_epi64(total, _mm_sad_epu8(_mm_and_si128(equalBytes(items + i, value), ones), zero));
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(sums), total);
+#endif
+			std::uint64_t bytes = 0;
+			for (std::uint64_t sum : sums) {
+				bytes += sum;
+			}
+			found = static_cast<int>(bytes / sizeof(T));
+		}
+#endif
+		for (; i < length; ++i) {
+			found += (items[i] == value) ? 1 : 0;
+		}
+		return found;
+	}
+};
+
+template <typename T, int Capacity = unrolledDefaults<T>::capacity>
+class unrolledList {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	linkedList spends one allocation and one pointer hop per value, so walking it is a cache miss per value.
+	Here each node stores up to Capacity values in an array (28 ints, 14 doubles), so a walk to an index
+	... skips whole nodes by their count and only touches about 1/Capacity as many nodes.
+
+	Nodes fill up completely when appending. Inserting into a full node splits it in two halves, and deleting
+	... tops a node that fell below half full back up from a neighbour, or merges the two once they fit in one.
+	So every node but the last is at least half full (appending fills the last one from empty).
+	The interface is linkedList's: initList, append, insert, deleteNode, at, top, back, print, copyList.
+	find() and count() search a node's array at a time, with vector compares for arithmetic values (see chunkSearch).
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+private:
+
+	typedef unrolledNode<T, Capacity> node;
+
+	node *head;
+	node *tail;
+	int length;
+	int nodes;
+
+	node *locate(int &index) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Find the node holding position index, and turn index into the position inside that node.
+		index must be in range.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		node *current = this->head;
+		while (index >= current->count) {
+			index -= current->count;
+			current = current->next;
+		}
+		return current;
+	}
+
+	node *newNode() {
+		++(this->nodes);
+		return new node();
+	}
+
+	void split(node *full) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Move the upper half of a full node into a new node right after it.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		node *upper = newNode();
+		const int keep = full->count / 2;
+		for (int i = keep; i < full->count; ++i) {
+			upper->items[i - keep] = full->items[i];
+		}
+		upper->count = full->count - keep;
+		full->count = keep;
+		upper->next = full->next;
+		full->next = upper;
+		if (this->tail == full) {
+			this->tail = upper;
+		}
+	}
+
+	void rebalance(node *first, node *second) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Even out two neighbouring nodes after one of them fell below half full. If all of their values fit in
+		... first, second is emptied into it and freed. Otherwise values move across the boundary, keeping
+		... their order, until the smaller one holds Capacity / 2.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (first->count + second->count <= Capacity) {
+			for (int i = 0; i < second->count; ++i) {
+				first->items[first->count + i] = second->items[i];
+			}
+			first->count += second->count;
+			first->next = second->next;
+			if (this->tail == second) {
+				this->tail = first;
+			}
+			delete second;
+			--(this->nodes);
+			return;
+		}
+		if (first->count < second->count) {
+			const int moved = Capacity / 2 - first->count;
+			for (int i = 0; i < moved; ++i) {
+				first->items[first->count + i] = second->items[i];
+			}
+			for (int i = moved; i < second->count; ++i) {
+				second->items[i - moved] = second->items[i];
+			}
+			first->count += moved;
+			second->count -= moved;
+		}
+		else {
+			const int moved = Capacity / 2 - second->count;
+			for (int i = second->count - 1; i >= 0; --i) {
+				second->items[i + moved] = second->items[i];
+			}
+			for (int i = 0; i < moved; ++i) {
+				second->items[i] = first->items[first->count - moved + i];
+			}
+			first->count -= moved;
+			second->count += moved;
+		}
+	}
+
+public:
+
+	unrolledList() : head(nullptr), tail(nullptr), length(0), nodes(0) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Basic constructor of the unrolled list. Assigns head and tail to nullptr.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+	}
+
+	unrolledList(const unrolledList &other) : unrolledList() {
+		copyList(other);
+	}
+
+	unrolledList &operator=(const unrolledList &other) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Assign one list's values into this list. Creates a deep copy.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this != &other) {
+			copyList(other);
+		}
+		return *this;
+	}
+
+	~unrolledList() {
+		destructList();
+	}
+
+	void initList(T value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Initialize the list with a single value. Any values already in the list are dropped.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		destructList();
+		append(value);
+	}
+
+	void destructList() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Free all of the memory used inside of the list, one node at a time (never recursively).
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		while (this->head != nullptr) {
+			node *next = this->head->next;
+			delete this->head;
+			this->head = next;
+		}
+		this->tail = nullptr;
+		this->length = 0;
+		this->nodes = 0;
+	}
+
+	void append(T what) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Append what to the end of the list. Starts a new node only when the last one is full.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->tail == nullptr) {
+			this->head = this->tail = newNode();
+		}
+		else if (this->tail->count == Capacity) {
+			this->tail->next = newNode();
+			this->tail = this->tail->next;
+		}
+		this->tail->items[(this->tail->count)++] = what;
+		++(this->length);
+	}
+
+	void insert(const int &where, T value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Insert value so that it becomes the element at position where (0 = new first element, length = append).
+		The values after it in its node shift up by one. Throws nullptrProbed if where is out of range.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (where < 0 || where > this->length) {
+			throw nullptrProbed(); // Can't access this value of the list, probe led to nullptr
+		}
+		if (where == this->length) {
+			append(value);
+			return;
+		}
+
+		int index = where;
+		node *current = locate(index);
+		if (current->count == Capacity) {
+			split(current);
+			if (index > current->count) {
+				index -= current->count;
+				current = current->next;
+			}
+		}
+		for (int i = current->count; i > index; --i) {
+			current->items[i] = current->items[i - 1];
+		}
+		current->items[index] = value;
+		++(current->count);
+		++(this->length);
+	}
+
+	void deleteNode(const int where) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Delete the value at position where. Where starts at 0 and goes to the length of the list.
+		Exception thrown if we go out of range. A node left below half full is rebalanced with its successor
+		... (or its predecessor, for the last node): the two are merged when they fit in one node, otherwise
+		... it borrows values until it's half full again. The neighbour had more than it can spare, so it stays
+		... at least half full too.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (where < 0 || where >= this->length) {
+			throw nullptrProbed(); // Can't access this value of the list, probe led to nullptr
+		}
+
+		node *previous = nullptr;
+		node *current = this->head;
+		int index = where;
+		while (index >= current->count) {
+			index -= current->count;
+			previous = current;
+			current = current->next;
+		}
+		for (int i = index; i + 1 < current->count; ++i) {
+			current->items[i] = current->items[i + 1];
+		}
+		--(current->count);
+		--(this->length);
+
+		if (current->count >= Capacity / 2) {
+			return;
+		}
+		if (current->next != nullptr) {
+			rebalance(current, current->next);
+		}
+		else if (previous != nullptr) {
+			rebalance(previous, current);
+		}
+		else if (current->count == 0) {
+			delete current;
+			this->head = this->tail = nullptr;
+			this->nodes = 0;
+		}
+	}
+
+	void copyList(const unrolledList &other) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Create a deep copy of a list, from other into *this. Copies node by node, keeping other's layout.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		destructList();
+		for (const node *source = other.head; source != nullptr; source = source->next) {
+			node *copy = newNode();
+			for (int i = 0; i < source->count; ++i) {
+				copy->items[i] = source->items[i];
+			}
+			copy->count = source->count;
+			(this->tail == nullptr ? this->head : this->tail->next) = copy;
+			this->tail = copy;
+		}
+		this->length = other.length;
+	}
+
+	void print() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Print all elements in the list in a python like list structure.
+		Gives "nullptr" string if null.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->head == nullptr) {
+			std::cout << "nullptr\n";
+			return;
+		}
+		std::cout << "<";
+		bool first = true;
+		for (node *current = this->head; current != nullptr; current = current->next) {
+			for (int i = 0; i < current->count; ++i) {
+				std::cout << (first ? "" : ", ") << current->items[i];
+				first = false;
+			}
+		}
+		std::cout << ">";
+	}
+
+	T at(int i) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Return the value of the list at an iteration point i.
+		If i goes outside of the list, exceptions are thrown.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (i < 0 || i >= this->length) {
+			throw nullptrProbed(); // Can't access this value of the list, probe led to nullptr
+		}
+		node *current = locate(i);
+		return current->items[i];
+	}
+
+	int find(const T &value) const {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Return the index of the first value equal to value, or -1 if there is none.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int before = 0;
+		for (const node *current = this->head; current != nullptr; current = current->next) {
+			const int found = chunkSearch<T>::find(current->items, current->count, value);
+			if (found != -1) {
+				return before + found;
+			}
+			before += current->count;
+		}
+		return -1;
+	}
+
+	template <typename Predicate>
+	int find_if(Predicate predicate) const {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Return the index of the first value for which predicate returns true, or -1 if there is none.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int before = 0;
+		for (const node *current = this->head; current != nullptr; current = current->next) {
+			for (int i = 0; i < current->count; ++i) {
+				if (predicate(current->items[i])) {
+					return before + i;
+				}
+			}
+			before += current->count;
+		}
+		return -1;
+	}
+
+	int count(const T &value) const {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Return how many values in the list are equal to value.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		int found = 0;
+		for (const node *current = this->head; current != nullptr; current = current->next) {
+			found += chunkSearch<T>::count(current->items, current->count, value);
+		}
+		return found;
+	}
+
+	T top() {
+		return this->head->items[0];
+	}
+
+	T back() {
+		return this->tail->items[this->tail->count - 1];
+	}
+
+	int getLength() {
+		return this->length;
+	}
+
+	int nodeCount() {
+		return this->nodes;
+	}
+
+	bool isEmpty() {
+		return (this->length == 0);
+	}
+};
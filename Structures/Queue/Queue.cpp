@@ -25,6 +25,17 @@ int main()
 	Q.push(3); 
 	std::cout << "\n\nTo check one more time, we will push 5 and 3 to the queue, and print the queue: ";
 	Q.print();
+	Q.clear();
+	std::cout << "\nclear() empties the queue: "; Q.print();
+
+	std::cout << "\n\nA queue of 10,000,000 values is freed node by node in a loop, not through nested destructors: ";
+	{
+		Queue<int> Large;
+		for (int i = 0; i < 10000000; ++i) {
+			Large.push(i);
+		}
+	}
+	std::cout << "destroyed without overflowing the call stack.";
 	std::cout << "\n\n";
 	std::cin.get();
 
@@ -10,21 +10,10 @@ upon a linked list like structure using nodes.
 #include <exception>
 #include <memory>
 
-struct nullptrProbed : public std::exception {
-
-	/// ------------------------------------------------------------------------------------ ///
-	/*
-	Custom exception. users do not want their program to continue when accessing a nullptr.
-	*/
-	/// ------------------------------------------------------------------------------------ ///
-
-	const char * what() const throw() {
-		return "Can't access this value of the queue, probe led to nullptr.";
-	}
-};
+#include "../nullptrProbed.h"
 
 template <typename T>
-struct Node {
+struct queueNode {
 
 	/// ------------------------------------------------------------------------------------ ///
 	/*
@@ -33,7 +22,7 @@ struct Node {
 	*/
 	/// ------------------------------------------------------------------------------------ ///
 
-	std::shared_ptr<Node<T>> next;
+	std::shared_ptr<queueNode<T>> next;
 	T data;
 
 };
@@ -53,8 +42,8 @@ class Queue {
 
 private:
 
-	std::shared_ptr<Node<T>> head;
-	std::shared_ptr<Node<T>> tail;
+	std::shared_ptr<queueNode<T>> head;
+	std::shared_ptr<queueNode<T>> tail;
 	int length;
 
 public:
@@ -72,6 +61,26 @@ public:
 		this->length = 0;
 	}
 
+	~Queue() {
+		clear();
+	}
+
+	void clear() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Remove every value. Letting go of the head at once would free the nodes through nested destructor calls,
+		... one per node, which overflows the call stack on a long queue. Walking the head forward frees them in a loop.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		while (this->head != nullptr) {
+			this->head = this->head->next;
+		}
+		this->tail = nullptr;
+		this->length = 0;
+	}
+
 	T pop() {
 
 		/// ------------------------------------------------------------------------------------ ///
@@ -85,7 +94,7 @@ public:
 			throw nullptrProbed(); // Can't access this value of the queue, probe led to nullptr
 		}
 		T content = this->head->data;
-		std::shared_ptr<Node<T>> first = std::make_shared<Node<T>>();
+		std::shared_ptr<queueNode<T>> first = std::make_shared<queueNode<T>>();
 		if (this->head->next == nullptr) {
 			first = nullptr;
 		}
@@ -105,7 +114,7 @@ public:
 		*/
 		/// ------------------------------------------------------------------------------------ ///
 
-		std::shared_ptr<Node<T>> newNode = std::make_shared<Node<T>>();
+		std::shared_ptr<queueNode<T>> newNode = std::make_shared<queueNode<T>>();
 		newNode->data = value;
 		++(this->length);
 		if (this->head == nullptr) {
@@ -138,7 +147,7 @@ public:
 			return;
 		}
 		std::cout << "[";
-		std::shared_ptr<Node<T>> current = this->head;
+		std::shared_ptr<queueNode<T>> current = this->head;
 		do {
 			if (current->next == nullptr) {
 				std::cout << current->data << "]";
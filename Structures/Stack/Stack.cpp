@@ -37,6 +37,17 @@ int main()
 	S.print();
 	S.push(4);
 	std::cout << "\nOf course, we can push 4 back to the empty stack and then print the stack: "; S.print();
+	S.clear();
+	std::cout << "\nclear() empties the stack: "; S.print();
+
+	std::cout << "\n\nA stack of 10,000,000 values is freed node by node in a loop, not through nested destructors: ";
+	{
+		Stack<int> Large;
+		for (int i = 0; i < 10000000; ++i) {
+			Large.push(i);
+		}
+	}
+	std::cout << "destroyed without overflowing the call stack.";
 	std::cout << "\n";
 	std::cin.get();
 
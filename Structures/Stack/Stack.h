@@ -11,31 +11,20 @@ upon a linked list like structure using nodes.
 #include <exception>
 #include <memory>
 
-struct nullptrProbed : public std::exception {
-
-	/// ------------------------------------------------------------------------------------ ///
-	/*
-	Custom exception. users do not want their program to continue when accessing a nullptr.
-	*/
-	/// ------------------------------------------------------------------------------------ ///
-
-	const char * what() const throw() {
-		return "Can't access this value of the stack, stack probe led to nullptr.";
-	}
-};
+#include "../nullptrProbed.h"
 
 template <typename T>
-struct Node {
+struct stackNode {
 
 	/// ------------------------------------------------------------------------------------ ///
 	/*
-	Node<T> class, has a pointer to the next node and a data value of type T.
+	stackNode<T> class, has a pointer to the next node and a data value of type T.
 	Not meant to be used or accessed outside of the stack structure.
 	*/
 	/// ------------------------------------------------------------------------------------ ///
 
 	T data;
-	std::shared_ptr<Node<T>> next;
+	std::shared_ptr<stackNode<T>> next;
 
 };
 
@@ -46,7 +35,7 @@ class Stack {
 	/*
 	Implementation of a stack through a linked list like structure.
 	Stacks have various applications -- think reversing a word, storing undos and redos, etc.
-	Each member of the stack is stored as a Node<T> pointer, in which each node has a next pointer
+	Each member of the stack is stored as a stackNode<T> pointer, in which each node has a next pointer
 	as well as a data value. Values are initialized as a nullptr and exceptions are thrown when
 	users try to use values with nullptrs.
 
@@ -56,7 +45,7 @@ class Stack {
 
 private:
 
-	std::shared_ptr<Node<T>> head;
+	std::shared_ptr<stackNode<T>> head;
 	int length;
 
 public:
@@ -73,6 +62,26 @@ public:
 		this->length = 0;
 	}
 
+	~Stack() {
+		clear();
+	}
+
+	void clear() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Remove every value. Each node's next pointer owns the rest of the stack, so letting the head go would free
+		... the nodes through one nested destructor call per node, and a long stack would overflow the call stack.
+		Instead the head is moved down one node at a time, so each node is freed with its next still held.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		while (this->head != nullptr) {
+			this->head = this->head->next;
+		}
+		this->length = 0;
+	}
+
 	void push(T value) {
 
 		/// ------------------------------------------------------------------------------------ ///
@@ -81,7 +90,7 @@ public:
 		*/
 		/// ------------------------------------------------------------------------------------ ///
 
-		std::shared_ptr<Node<T>> entry = std::make_shared<Node<T>>();
+		std::shared_ptr<stackNode<T>> entry = std::make_shared<stackNode<T>>();
 		entry->data = value;
 		if (!(this->head)) {
 			entry->next = nullptr;
@@ -105,7 +114,7 @@ public:
 			throw nullptrProbed(); // Can't access this value of the stack, stack probe led to nullptr
 		}
 		else {
-			std::shared_ptr<Node<T>> top = this->head;
+			std::shared_ptr<stackNode<T>> top = this->head;
 			if (!(this->head->next == nullptr)) {
 				this->head = this->head->next;
 			}
@@ -147,7 +156,7 @@ public:
 		}
 		else {
 			std::cout << "[";
-			std::shared_ptr<Node<T>> current = this->head;
+			std::shared_ptr<stackNode<T>> current = this->head;
 			do {
 				std::cout << current->data;
 				current = current->next;
@@ -0,0 +1,157 @@
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "arrayStack.h"
+
+int evaluate(const std::string &postfix) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Evaluate a postfix expression of single digits, + - and *, e.g. "34+2*" is (3 + 4) * 2.
+	The classic use of a stack: the operands wait on it until their operator comes.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	arrayStack<int> operands;
+	for (char symbol : postfix) {
+		if (symbol >= '0' && symbol <= '9') {
+			operands.push(symbol - '0');
+			continue;
+		}
+		const int right = operands.pop();
+		const int left = operands.pop();
+		operands.push(symbol == '+' ? left + right : symbol == '-' ? left - right : left * right);
+	}
+	return operands.pop();
+}
+
+bool matchesVector(const int rounds) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Random pushes, emplaces, pops and try_pops on an arrayStack<std::string> and a std::vector, compared after
+	... every call. A small inline buffer makes the stack move to the heap early. Copies and moves are
+	... checked along the way, both while the values are inline and once they're on the heap.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	arrayStack<std::string, 4> S;
+	std::vector<std::string> expected;
+	std::mt19937 generator(25);
+	for (int i = 0; i < rounds; ++i) {
+		const int choice = static_cast<int>(generator() % 8);
+		if (choice < 3) {
+			const std::string value = "pokemon #" + std::to_string(i);
+			S.push(value);
+			expected.push_back(value);
+		}
+		else if (choice == 3) {
+			S.emplace(3, static_cast<char>('a' + i % 26));
+			expected.emplace_back(3, static_cast<char>('a' + i % 26));
+		}
+		else if (choice == 4 && !expected.empty()) {
+			S.push(S.peek()); // The pushed value lives in the array that may be replaced.
+			expected.push_back(expected.back());
+		}
+		else if (choice == 5) {
+			std::string value = "unchanged";
+			const bool popped = S.try_pop(value);
+			if (popped != !expected.empty() || (popped ? value != expected.back() : value != "unchanged")) {
+				return false;
+			}
+			if (popped) {
+				expected.pop_back();
+			}
+		}
+		else if (choice == 6 && expected.size() % 5 == 0) {
+			arrayStack<std::string, 4> copy(S);
+			arrayStack<std::string, 4> moved(std::move(copy));
+			S = moved;
+			moved = std::move(S);
+			S = std::move(moved);
+			if (!copy.isEmpty() || !moved.isEmpty()) {
+				return false;
+			}
+		}
+		else if (!expected.empty()) {
+			if (S.pop() != expected.back()) {
+				return false;
+			}
+			expected.pop_back();
+		}
+		if (S.getLength() != static_cast<int>(expected.size()) || S.isEmpty() != expected.empty() ||
+			S.isInline() != (S.capacity() == 4)) {
+			return false;
+		}
+		if (!expected.empty() && S.peek() != expected.back()) {
+			return false;
+		}
+	}
+	while (!expected.empty()) {
+		if (S.pop() != expected.back()) {
+			return false;
+		}
+		expected.pop_back();
+	}
+	return S.isEmpty();
+}
+
+int main()
+{
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Gain a few insights on how to use the array backed stack, and see a testable demo that checks it against std::vector.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	std::cout << "Declaration of an array backed stack: arrayStack<data_type> stack_name.\n" << \
+		"It is used like a Stack, but keeps its values in one array, the first 32 of them inside the stack itself:\n";
+	arrayStack<int> S;
+	S.push(4);
+	S.push(5);
+	S.push(2);
+	std::cout << "Value of the stack after pushing 4, 5, and then 2: ";
+	S.print();
+	S.pop();
+	std::cout << "\nAfter one pop, peek returns: " << S.peek() << ", and the values are still inline: " << S.isInline();
+
+	std::cout << "\n\ntry_pop returns false instead of throwing when the stack is empty: ";
+	int value = 0;
+	S.clear();
+	const bool emptyPopped = S.try_pop(value);
+	std::cout << emptyPopped;
+	bool threw = false;
+	try {
+		S.pop();
+	}
+	catch (const nullptrProbed &error) {
+		threw = true;
+		std::cout << "\npop still throws nullptrProbed: " << error.what();
+	}
+
+	for (int i = 0; i < 100; ++i) {
+		S.push(i);
+	}
+	std::cout << "\n\nPast 32 values the stack moves to the heap and doubles as needed. After 100 pushes, capacity: " << \
+		S.capacity() << ", inline: " << S.isInline();
+
+	std::cout << "\n\nemplace builds the value in place, and move-only values work too: ";
+	arrayStack<std::unique_ptr<std::string>> Owners;
+	Owners.emplace(new std::string("Pikachu"));
+	Owners.push(std::unique_ptr<std::string>(new std::string("Eevee")));
+	std::unique_ptr<std::string> top;
+	Owners.try_pop(top);
+	std::cout << *top << " then " << *Owners.peek();
+
+	std::cout << "\n\nA postfix evaluator: 34+2*93-* = " << evaluate("34+2*93-*");
+
+	std::cout << "\n\nRandom pushes, emplaces and pops compared against std::vector: ";
+	const bool passed = !emptyPopped && threw && evaluate("34+2*93-*") == 84 && *top == "Eevee" && matchesVector(200000);
+	std::cout << (passed ? "passed" : "FAILED") << "\n\n";
+
+	std::cin.get();
+	return passed ? 0 : 1;
+}
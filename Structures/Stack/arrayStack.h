@@ -0,0 +1,370 @@
+#pragma once
+
+/// ------------------------------------------------------------------------------------ ///
+/*
+The following .h file includes an implementation of the stack data structure in C++, based
+upon one contiguous array that grows as needed, with room for the first values inside the stack itself.
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <iostream>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../nullptrProbed.h"
+
+template <typename T, int Inline = 32>
+class arrayStack {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Stack keeps every value in a node of its own, so each push allocates and each pop frees. Here the values
+	... sit in one array, bottom to top: a push constructs the value in the next free slot and a pop destroys
+	... the top one, so neither allocates unless the array is full.
+
+	The first Inline values live in a buffer inside the arrayStack object, so a stack that never gets deeper
+	... than that (an expression evaluator, most searches) never touches the heap at all. Past that, the
+	... values move to a heap array that doubles whenever it fills up. clear() and pop() keep the array.
+	Pushing may move every value to a new array, so references to values are only good until the next push.
+
+	The interface is Stack's (push, pop, peek, print, clear, isEmpty, getLength), plus emplace and try_pop.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	static_assert(Inline > 0, "The inline buffer needs room for at least one value.");
+
+private:
+
+	typedef std::allocator<T> allocator;
+
+	alignas(T) unsigned char buffer[Inline * sizeof(T)];
+	T *items;
+	int length;
+	int room;
+
+	T *inlineItems() {
+		return reinterpret_cast<T *>(this->buffer);
+	}
+
+	bool onHeap() const {
+		return (this->items != reinterpret_cast<const T *>(this->buffer));
+	}
+
+	static void relocate(T *from, T *to, const int count) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Move count values from one array into uninitialized memory, and destroy the originals.
+		Trivially copyable values are copied as bytes. Other values are moved, unless moving could throw and
+		... copying can't, then they are copied, so a throwing move can't leave values behind in both arrays.
+		If a copy throws, the ones made so far are destroyed and the originals are left as they were.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (std::is_trivially_copyable<T>::value) {
+			if (count > 0) {
+				std::memcpy(static_cast<void *>(to), static_cast<const void *>(from), count * sizeof(T));
+			}
+			return;
+		}
+		int made = 0;
+		try {
+			for (; made < count; ++made) {
+				::new (static_cast<void *>(to + made)) T(std::move_if_noexcept(from[made]));
+			}
+		}
+		catch (...) {
+			destroy(to, made);
+			throw;
+		}
+		destroy(from, count);
+	}
+
+	static void destroy(T *first, const int count) {
+		if (!std::is_trivially_destructible<T>::value) {
+			for (int i = 0; i < count; ++i) {
+				first[i].~T();
+			}
+		}
+	}
+
+	void release() {
+		if (onHeap()) {
+			allocator().deallocate(this->items, static_cast<std::size_t>(this->room));
+			this->items = inlineItems();
+			this->room = Inline;
+		}
+	}
+
+	template <typename... Args>
+	T &emplaceGrowing(Args&&... args) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		emplace onto a full array: build the value in a new array of twice the room, then move the others over.
+		The new value is built first, since args may refer to a value in the old array.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		const int grown = this->room * 2;
+		T *larger = allocator().allocate(static_cast<std::size_t>(grown));
+		T *top = larger + this->length;
+		try {
+			::new (static_cast<void *>(top)) T(std::forward<Args>(args)...);
+			try {
+				relocate(this->items, larger, this->length);
+			}
+			catch (...) {
+				top->~T();
+				throw;
+			}
+		}
+		catch (...) {
+			allocator().deallocate(larger, static_cast<std::size_t>(grown));
+			throw;
+		}
+		release();
+		this->items = larger;
+		this->room = grown;
+		++(this->length);
+		return *top;
+	}
+
+	void take(arrayStack &&other) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Take other's values into this empty stack, with the inline buffer in use. A heap array is taken
+		... whole, inline values are moved one by one. other is left empty.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (other.onHeap()) {
+			this->items = other.items;
+			this->room = other.room;
+			this->length = other.length;
+			other.items = other.inlineItems();
+			other.room = Inline;
+		}
+		else {
+			relocate(other.items, this->items, other.length);
+			this->length = other.length;
+		}
+		other.length = 0;
+	}
+
+public:
+
+	arrayStack() : items(inlineItems()), length(0), room(Inline) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Default stack constructor. The stack starts out empty, on its inline buffer.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+	}
+
+	arrayStack(const arrayStack &other) : arrayStack() {
+		reserve(other.length);
+		for (int i = 0; i < other.length; ++i) {
+			push(other.items[i]);
+		}
+	}
+
+	arrayStack(arrayStack &&other) noexcept(std::is_nothrow_move_constructible<T>::value) : arrayStack() {
+		take(std::move(other));
+	}
+
+	arrayStack &operator=(const arrayStack &other) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Assign one stack's values into this stack. Creates a deep copy.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this != &other) {
+			clear();
+			reserve(other.length);
+			for (int i = 0; i < other.length; ++i) {
+				push(other.items[i]);
+			}
+		}
+		return *this;
+	}
+
+	arrayStack &operator=(arrayStack &&other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Take other's values, leaving other empty. Any values already in this stack are dropped.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this != &other) {
+			clear();
+			release();
+			take(std::move(other));
+		}
+		return *this;
+	}
+
+	~arrayStack() {
+		clear();
+		release();
+	}
+
+	void clear() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Remove every value. The array is kept for the values pushed next.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		destroy(this->items, this->length);
+		this->length = 0;
+	}
+
+	void reserve(const int count) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Make room for count values, so pushing up to count values won't move the array again.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (count <= this->room) {
+			return;
+		}
+		T *larger = allocator().allocate(static_cast<std::size_t>(count));
+		try {
+			relocate(this->items, larger, this->length);
+		}
+		catch (...) {
+			allocator().deallocate(larger, static_cast<std::size_t>(count));
+			throw;
+		}
+		release();
+		this->items = larger;
+		this->room = count;
+	}
+
+	template <typename... Args>
+	T &emplace(Args&&... args) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Build a value on top of the stack from args, and return it.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->length == this->room) {
+			return emplaceGrowing(std::forward<Args>(args)...);
+		}
+		T *top = ::new (static_cast<void *>(this->items + this->length)) T(std::forward<Args>(args)...);
+		++(this->length);
+		return *top;
+	}
+
+	void push(const T &value) {
+		emplace(value);
+	}
+
+	void push(T &&value) {
+		emplace(std::move(value));
+	}
+
+	T pop() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Remove the value on top of the stack, in other words the last value pushed, and return it.
+		Throws nullptrProbed if the stack is empty.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->length == 0) {
+			throw nullptrProbed(); // Can't access this value of the stack, stack probe led to nullptr
+		}
+		T *top = this->items + this->length - 1;
+		T value(std::move(*top));
+		top->~T();
+		--(this->length);
+		return value;
+	}
+
+	bool try_pop(T &value) noexcept(std::is_nothrow_move_assignable<T>::value) {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		pop() without the exception: move the top value into value and return true, or return false if
+		... the stack is empty and leave value alone.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->length == 0) {
+			return false;
+		}
+		T *top = this->items + this->length - 1;
+		value = std::move(*top);
+		top->~T();
+		--(this->length);
+		return true;
+	}
+
+	T &peek() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Find the value on top of the stack, but do not remove it.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->length == 0) {
+			throw nullptrProbed(); // Can't access this value of the stack, stack probe led to nullptr
+		}
+		return this->items[this->length - 1];
+	}
+
+	void print() {
+
+		/// ------------------------------------------------------------------------------------ ///
+		/*
+		Print all elements in the stack, top first, like Stack::print. Does not include \n.
+		Prints nullptr if empty.
+		*/
+		/// ------------------------------------------------------------------------------------ ///
+
+		if (this->length == 0) {
+			std::cout << "nullptr";
+			return;
+		}
+		std::cout << "[";
+		for (int i = this->length - 1; i >= 0; --i) {
+			std::cout << this->items[i] << (i > 0 ? ", " : "");
+		}
+		std::cout << "]";
+	}
+
+	bool isEmpty() const {
+		return (this->length == 0);
+	}
+
+	int getLength() const {
+		return this->length;
+	}
+
+	int capacity() const {
+		return this->room;
+	}
+
+	bool isInline() const {
+		return !onHeap();
+	}
+};
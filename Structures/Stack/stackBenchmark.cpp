@@ -0,0 +1,85 @@
+/// ------------------------------------------------------------------------------------ ///
+/*
+Timing harness for the stacks. Not a demo, build it with optimizations on:
+g++ -O2 -std=c++17 stackBenchmark.cpp -o stackBenchmark
+Pass stack depths as arguments (default 1000 1000000 10000000).
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Stack.h"
+#include "arrayStack.h"
+
+double millisecondsSince(const std::chrono::steady_clock::time_point &start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const std::string &name, const std::string &operation, const double milliseconds, const int operations) {
+	std::cout << name << " | " << operation << ": " << milliseconds << " ms, " << \
+		(milliseconds * 1000000.0 / operations) << " ns/op\n";
+}
+
+template <typename Stacked>
+void benchmarkStack(const std::string &name, const int depth) {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Time depth pushes followed by depth pops, then a search-like pattern that stays shallow: push two values,
+	... pop one, and pop everything every 16 rounds, for depth rounds. The checksum keeps the compiler from
+	... dropping the pops.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	long long checksum = 0;
+	{
+		Stacked S;
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < depth; ++i) {
+			S.push(i);
+		}
+		report(name, "push   ", millisecondsSince(start), depth);
+
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < depth; ++i) {
+			checksum += S.pop();
+		}
+		report(name, "pop    ", millisecondsSince(start), depth);
+	}
+
+	Stacked S;
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < depth; ++i) {
+		S.push(i);
+		S.push(i + 1);
+		checksum += S.pop();
+		if (i % 16 == 15) {
+			while (!S.isEmpty()) {
+				checksum += S.pop();
+			}
+		}
+	}
+	report(name, "shallow", millisecondsSince(start), depth * 3);
+	std::cout << "(checksum " << checksum << ")\n";
+}
+
+int main(int argc, char **argv) {
+
+	std::vector<int> depths;
+	for (int i = 1; i < argc; ++i) {
+		depths.push_back(std::atoi(argv[i]));
+	}
+	if (depths.empty()) {
+		depths = { 1000, 1000000, 10000000 };
+	}
+
+	for (int depth : depths) {
+		std::cout << "\n" << depth << " values\n";
+		benchmarkStack<Stack<int>>("Stack     ", depth);
+		benchmarkStack<arrayStack<int>>("arrayStack", depth);
+	}
+	return 0;
+}
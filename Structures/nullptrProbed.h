@@ -0,0 +1,23 @@
+#pragma once
+
+/// ------------------------------------------------------------------------------------ ///
+/*
+The following .h file includes the exception shared by the list, stack and queue headers. Each of those
+names its own node type (stackNode, queueNode, ...), so any of them can be included together.
+*/
+/// ------------------------------------------------------------------------------------ ///
+
+#include <exception>
+
+struct nullptrProbed : public std::exception {
+
+	/// ------------------------------------------------------------------------------------ ///
+	/*
+	Custom exception. users do not want their program to continue when accessing a nullptr.
+	*/
+	/// ------------------------------------------------------------------------------------ ///
+
+	const char * what() const throw() {
+		return "Can't access this value of the structure, probe led to nullptr.";
+	}
+};